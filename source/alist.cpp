@@ -28,6 +28,18 @@
 AListElem::AListElem()
 {
 	sortString = 0;
+	next = 0;
+	prev = 0;
+	owner = 0;
+}
+
+AListElem::AListElem(const AListElem & e)
+{
+	sortString = 0;
+	next = 0;
+	prev = 0;
+	owner = 0;
+	if (e.sortString) SetSortString(e.sortString);
 }
 
 AListElem::~AListElem()
@@ -36,6 +48,14 @@ AListElem::~AListElem()
 		delete sortString;
 }
 
+AListElem & AListElem::operator=(const AListElem & e)
+{
+	if (this != &e) {
+		if (e.sortString) SetSortString(e.sortString);
+	}
+	return *this;
+}
+
 void AListElem::SetSortString(const char * str)
 {
 	if (sortString)
@@ -50,14 +70,23 @@ AList::AList() {
 	list = 0;
 	lastelem = 0;
 	num = 0;
+	iters = 0;
 }
 
 AList::~AList() {
 	DeleteAll();
+	while (iters) {
+		iters->list = 0;
+		iters = iters->nextiter;
+	}
 }
 
 void AList::DeleteAll() {
 	AListElem * temp;
+	for (AListIter *it = iters; it; it = it->nextiter) {
+		it->cur = 0;
+		it->last = 0;
+	}
 	while (list) {
 		temp = list->next;
 		delete list;
@@ -69,9 +98,15 @@ void AList::DeleteAll() {
 
 void AList::Empty() {
 	AListElem * temp;
+	for (AListIter *it = iters; it; it = it->nextiter) {
+		it->cur = 0;
+		it->last = 0;
+	}
 	while (list) {
 		temp = list->next;
 		list->next = 0;
+		list->prev = 0;
+		list->owner = 0;
 		list = temp;
 	}
 	lastelem = 0;
@@ -80,15 +115,17 @@ void AList::Empty() {
 
 void AList::Insert(AListElem * e) {
 	num ++;
+	e->owner = this;
 	e->prev = 0;
 	e->next = list;
+	if (list) list->prev = e;
 	list = e;
-	list->prev = e;
 	if (!lastelem) lastelem = list;
 }
 
 void AList::Add(AListElem * e) {
 	num ++;
+	e->owner = this;
 	if (list) {
 		e->prev = lastelem;
 		lastelem->next = e;
@@ -112,38 +149,125 @@ AListElem * AList::First() {
 }
 
 AListElem * AList::Get(AListElem * e) {
-	AListElem * temp = list;
-	while (temp) {
-		if (temp == e) return temp;
-		temp = temp->next;
-	}
+	if (e && e->owner == this) return e;
 	return 0;
 }
 
 char AList::Remove(AListElem * e) {
-	if (!e) return 0;
-	if (!e->next) lastelem = 0;
+	if (!e || e->owner != this) return 0;
 
-	for (AListElem **pp = &list; *pp; pp = &((*pp)->next)) {
-		if (*pp == e) {
-			*pp = e->next;
-			num--;
-			return 1;
-		}
-		if (!e->next) lastelem = *pp;
-	}
-	return 0;
+	for (AListIter *it = iters; it; it = it->nextiter)
+		it->Removing(e);
+
+	if (e->prev) e->prev->next = e->next;
+	else list = e->next;
+	if (e->next) e->next->prev = e->prev;
+	else lastelem = e->prev;
+
+	e->owner = 0;
+	num--;
+	return 1;
 }
 
 int AList::Num() {
 	return num;
 }
 
-int AList::NextLive(AListElem **copy, int size, int pos) {
-	while (++pos < size) {
-		for (AListElem *elem = First(); elem; elem = elem->next) {
-			if (elem == copy[pos]) return pos;
+AListIndex::AListIndex() {
+	keys = 0;
+	elems = 0;
+	num = 0;
+	size = 0;
+}
+
+AListIndex::~AListIndex() {
+	delete [] keys;
+	delete [] elems;
+}
+
+/* Position of the first key not less than k */
+int AListIndex::Search(int k) {
+	int lo = 0, hi = num;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (keys[mid] < k) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+AListElem * AListIndex::Find(int k) {
+	int i = Search(k);
+	if (i < num && keys[i] == k) return elems[i];
+	return 0;
+}
+
+int AListIndex::Insert(int k, AListElem * e) {
+	int i = Search(k);
+	if (i < num && keys[i] == k) return 0;
+	if (num == size) {
+		int newsize = size ? size * 2 : 4;
+		int *newkeys = new int[newsize];
+		AListElem **newelems = new AListElem *[newsize];
+		for (int j = 0; j < num; j++) {
+			newkeys[j] = keys[j];
+			newelems[j] = elems[j];
 		}
+		delete [] keys;
+		delete [] elems;
+		keys = newkeys;
+		elems = newelems;
+		size = newsize;
 	}
-	return pos;
+	for (int j = num; j > i; j--) {
+		keys[j] = keys[j-1];
+		elems[j] = elems[j-1];
+	}
+	keys[i] = k;
+	elems[i] = e;
+	num++;
+	return 1;
+}
+
+void AListIndex::Erase(int k) {
+	int i = Search(k);
+	if (i >= num || keys[i] != k) return;
+	num--;
+	for (int j = i; j < num; j++) {
+		keys[j] = keys[j+1];
+		elems[j] = elems[j+1];
+	}
+}
+
+void AListIndex::Clear() {
+	num = 0;
+}
+
+AListIter::AListIter(AList * l) {
+	list = l;
+	cur = l->list;
+	last = l->lastelem;
+	nextiter = l->iters;
+	l->iters = this;
+}
+
+AListIter::~AListIter() {
+	if (!list) return;
+	for (AListIter **pp = &list->iters; *pp; pp = &((*pp)->nextiter)) {
+		if (*pp == this) {
+			*pp = nextiter;
+			break;
+		}
+	}
+}
+
+AListElem * AListIter::Next() {
+	AListElem *e = cur;
+	if (e) cur = (e == last) ? 0 : e->next;
+	return e;
+}
+
+void AListIter::Removing(AListElem * e) {
+	if (e == cur) cur = (e == last) ? 0 : e->next;
+	if (e == last) last = e->prev;
 }
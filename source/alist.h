@@ -32,17 +32,23 @@
 
 class AListElem;
 class AList;
+class AListIter;
 
 class AListElem {
 	public:
 		AListElem();
+		AListElem(const AListElem &);
 		virtual ~AListElem();
 
+		/* Copies never inherit list membership */
+		AListElem & operator=(const AListElem &);
+
 		void SetSortString(const char *);
 
 		char * sortString;
 		AListElem * next;
 		AListElem * prev;
+		AList * owner;
 #ifdef __USE_GUI__
 		wxTreeItemId treeId;
 #endif
@@ -63,13 +69,63 @@ class AList {
 		AListElem * First();
 		int Num();
 
-		/* Helper function for forlist_safe */
-		int NextLive(AListElem **copy, int size, int pos);
-
 	private:
+		friend class AListIter;
+
 		AListElem *list;
 		AListElem *lastelem;
 		int num;
+		AListIter *iters; /* Live forlist_safe iterators */
+};
+
+//
+// Iterator used by forlist_safe.  It visits the elements present when
+// the loop started, in order, and skips any of them that are removed
+// from the list before being reached.  Elements added during the loop
+// are not visited.  The list keeps track of its live iterators and
+// fixes them up in Remove(), so each step is O(1).
+//
+class AListIter {
+	public:
+		AListIter(AList *);
+		~AListIter();
+
+		AListElem * Next();
+
+	private:
+		friend class AList;
+
+		void Removing(AListElem *);
+
+		AList *list;
+		AListElem *cur;  /* Next element to visit */
+		AListElem *last; /* Last element to visit */
+		AListIter *nextiter;
+};
+
+//
+// A sorted array mapping an integer key to a list element, for lists
+// that are looked up by type far more often than they change (ItemList
+// and SkillList).  The list itself still holds the elements and their
+// order; this only finds them.
+//
+class AListIndex {
+	public:
+		AListIndex();
+		~AListIndex();
+
+		AListElem * Find(int);
+		int Insert(int, AListElem *); /* 0 if the key is already there */
+		void Erase(int);
+		void Clear();
+
+	private:
+		int Search(int);
+
+		int *keys;
+		AListElem **elems;
+		int num;
+		int size;
 };
 
 #define forlist(l) \
@@ -81,15 +137,8 @@ class AList {
 			_elem2 = (_elem2 ? ((l)->Next(_elem2)) : 0))
 
 #define forlist_safe(l) \
-	int size = (l)->Num(); \
-	AListElem **copy = new AListElem*[size]; \
 	AListElem *elem; \
-	int pos; \
-	for (pos = 0, elem = (l)->First(); elem; elem = elem->next, pos++) { \
-		copy[pos] = elem; \
-	} \
-	for (pos = 0; \
-			pos < size ? (elem = copy[pos], 1) : (delete [] copy, 0); \
-			pos = (l)->NextLive(copy, size, pos))
+	AListIter _iter(l); \
+	while ((elem = _iter.Next()) != 0)
 
 #endif
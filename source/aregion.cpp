@@ -64,6 +64,14 @@ Farsight *GetFarsight(AList *l,Faction *fac) {
 	return 0;
 }
 
+static int curvisionstamp = 0;
+
+void InvalidateVision() {
+	// Region tasks on worker threads leave this to the end of the phase
+	if (CurrentFactionLog()) return;
+	curvisionstamp++;
+}
+
 AString TownString(int i) {
 	switch (i) {
 	case TOWN_VILLAGE:
@@ -112,8 +120,13 @@ ARegion::ARegion() {
 	buildingseq = 1;
 	gate = 0;
 	town = 0;
+	visionstamp = -1;
 	clearskies = 0;
 	earthlore = 0;
+	wmons = 0;
+	guards = 0;
+	sector = 0;
+	wmonfreq = 0;
 	ZeroNeighbors();
 	//
 	// Make the dummy object
@@ -1956,15 +1969,8 @@ void ARegion::WriteReport(Areport * f,Faction * fac,int month, ARegionList *pReg
 			passscout = 10;
 		}
 
-		forlist (&objects) {
-			Object * o = (Object *) elem;
-			forlist(&o->units) {
-				Unit * u = (Unit *) elem;
-				if (u->faction == fac && u->GetSkill(S_MIND_READING) > 2) {
-					detfac = 1;
-				}
-			}
-		}
+		FactionVision *v = GetVision(fac);
+		if (v && v->mindreading > 2) detfac = 1;
 		if (Globals->IMPROVED_FARSIGHT && farsight) {
 			forlist(&farsees) {
 				Farsight *watcher = (Farsight *)elem;
@@ -2110,16 +2116,8 @@ int ARegion::GetTrueSight(Faction *f, int usepassers) {
 		}
 	}
 
-	forlist ((&objects)) {
-		Object * obj = (Object *) elem;
-		forlist ((&obj->units)) {
-			Unit * u = (Unit *) elem;
-			if (u->faction == f) {
-				int temp = u->GetSkill(S_TRUE_SEEING);
-				if (temp>truesight) truesight = temp;
-			}
-		}
-	}
+	FactionVision *v = GetVision(f);
+	if (v && v->truesight > truesight) truesight = v->truesight;
 	return truesight;
 }
 
@@ -2148,16 +2146,8 @@ int ARegion::GetObservation(Faction * f, int usepassers) {
 		}
 	}
 
-	forlist ((&objects)) {
-		Object * obj = (Object *) elem;
-		forlist ((&obj->units)) {
-			Unit * u = (Unit *) elem;
-			if (u->faction == f) {
-				int temp = u->GetSkill(S_OBSERVATION);
-				if (temp>obs) obs = temp;
-			}
-		}
-	}
+	FactionVision *v = GetVision(f);
+	if (v && v->observation > obs) obs = v->observation;
 	return obs;
 }
 
@@ -2186,17 +2176,54 @@ int ARegion::GetScout(Faction * f, int usepassers) {
 		}
 	}
 
-	forlist ((&objects)) {
-		Object * obj = (Object *) elem;
-		forlist ((&obj->units)) {
-			Unit * u = (Unit *) elem;
-			if (u->faction == f) {
-				int temp = u->GetSkill(S_SCOUTING);
-				if (temp>scout) scout = temp;
+	FactionVision *v = GetVision(f);
+	if (v && v->scout > scout) scout = v->scout;
+	return scout;
+}
+
+FactionVision *ARegion::GetVision(Faction *f) {
+	if (visionstamp != curvisionstamp) UpdateVision();
+	forlist(&vision) {
+		FactionVision *v = (FactionVision *) elem;
+		if (v->faction == f) return v;
+	}
+	return 0;
+}
+
+void ARegion::UpdateVision() {
+	vision.DeleteAll();
+	forlist(&objects) {
+		Object *o = (Object *) elem;
+		forlist(&o->units) {
+			Unit *u = (Unit *) elem;
+			FactionVision *v = 0;
+			forlist(&vision) {
+				FactionVision *fv = (FactionVision *) elem;
+				if (fv->faction == u->faction) {
+					v = fv;
+					break;
+				}
+			}
+			if (!v) {
+				v = new FactionVision;
+				v->faction = u->faction;
+				v->observation = 0;
+				v->truesight = 0;
+				v->scout = 0;
+				v->mindreading = 0;
+				vision.Add(v);
 			}
+			int temp = u->GetSkill(S_OBSERVATION);
+			if (temp > v->observation) v->observation = temp;
+			temp = u->GetSkill(S_TRUE_SEEING);
+			if (temp > v->truesight) v->truesight = temp;
+			temp = u->GetSkill(S_SCOUTING);
+			if (temp > v->scout) v->scout = temp;
+			temp = u->GetSkill(S_MIND_READING);
+			if (temp > v->mindreading) v->mindreading = temp;
 		}
 	}
-	return scout;
+	visionstamp = curvisionstamp;
 }
 
 void ARegion::SetWeather(int newWeather) {
@@ -2387,34 +2414,64 @@ int ARegion::HasShaft() {
 }
 
 int ARegion::IsGuarded() {
-	forlist (&objects) {
-		Object * o = (Object *) elem;
-		forlist (&o->units) {
-			Unit * u = (Unit *) elem;
-			if (u->guard == GUARD_GUARD) return 1;
-		}
-	}
-	return 0;
+	return guards > 0;
 }
 
 int ARegion::CountWMons() {
-	int count = 0;
-	forlist (&objects) {
-		Object * o = (Object *) elem;
-		forlist (&o->units) {
-			Unit * u = (Unit *) elem;
-			if (u->type == U_WMON) {
-				count ++;
-			}
-		}
+	return wmons;
+}
+
+//
+// Add (n = 1) or take away (n = -1) the unit from the counts, and pass
+// the change on to the sector, which only counts unguarded regions.
+//
+void ARegion::CountUnit(Unit *u, int n) {
+	if (u->type != U_WMON && u->guard != GUARD_GUARD) return;
+	if (sector && !guards) {
+		sector->wmons -= wmons;
+		sector->wanted -= wmonfreq;
 	}
-	return count;
+	if (u->type == U_WMON) wmons += n;
+	if (u->guard == GUARD_GUARD) guards += n;
+	if (sector && !guards) {
+		sector->wmons += wmons;
+		sector->wanted += wmonfreq;
+	}
+}
+
+//
+// The wandering monster frequency of the terrain, or 0 if none of its
+// monster types are enabled.
+//
+int ARegion::WMonFreq() {
+	int avail = 0;
+	int mon = TerrainDefs[type].smallmon;
+	if (!((mon == -1) || (ItemDefs[mon].flags & ItemType::DISABLED)))
+		avail = 1;
+	mon = TerrainDefs[type].bigmon;
+	if (!((mon == -1) || (ItemDefs[mon].flags & ItemType::DISABLED)))
+		avail = 1;
+	mon = TerrainDefs[type].humanoid;
+	if (!((mon == -1) || (ItemDefs[mon].flags & ItemType::DISABLED)))
+		avail = 1;
+	if (!avail) return 0;
+	return TerrainDefs[type].wmonfreq;
+}
+
+void ARegion::SetType(int t) {
+	if (sector && !guards) sector->wanted -= wmonfreq;
+	type = t;
+	if (sector) wmonfreq = WMonFreq();
+	if (sector && !guards) sector->wanted += wmonfreq;
 }
 
 ARegionList::ARegionList() {
 	pRegionArrays = 0;
 	numLevels = 0;
 	numberofgates = 0;
+	sectorsReady = 0;
+	xscale = 0;
+	yscale = 0;
 }
 
 ARegionList::~ARegionList() {
@@ -2426,6 +2483,8 @@ ARegionList::~ARegionList() {
 
 		delete pRegionArrays;
 	}
+	delete [] xscale;
+	delete [] yscale;
 }
 
 void ARegionList::WriteRegions(Aoutfile * f) {
@@ -2475,27 +2534,18 @@ int ARegionList::ReadRegions(Ainfile * f,AList * factions, ATL_VER v) {
 	for(i = 0; i < numLevels; i++) {
 		int curX = f->GetInt();
 		int curY = f->GetInt();
-		AString *name = f->GetStr();
 		ARegionArray *pRegs = new ARegionArray(curX, curY);
-		if (*name == "none") {
-			pRegs->strName = 0;
-			delete name;
-		} else {
-			pRegs->strName = name;
-		}
+		pRegs->strName = f->GetStrOrNone();
 		pRegs->levelType = f->GetInt();
 		pRegionArrays[ i ] = pRegs;
 	}
 
 	numberofgates = f->GetInt();
 
-	ARegionFlatArray fa(num);
-
 	Awrite("Reading the regions...");
 	for(i = 0; i < num; i++) {
 		ARegion *temp = new ARegion;
 		temp->Readin(f,factions,v);
-		fa.SetRegion(temp->num,temp);
 		Add(temp);
 
 		pRegionArrays[ temp->zloc ]->SetRegion(temp->xloc, temp->yloc,
@@ -2504,13 +2554,14 @@ int ARegionList::ReadRegions(Ainfile * f,AList * factions, ATL_VER v) {
 
 	Awrite("Setting up the neighbors...");
 	{
-		delete f->GetStr();
+		int len;
+		f->GetView(&len);
 		forlist(this) {
 			ARegion * reg = (ARegion *) elem;
 			for(i = 0; i < NDIRS; i++) {
 				int j = f->GetInt();
 				if (j != -1) {
-					reg->neighbors[i] = fa.GetRegion(j);
+					reg->neighbors[i] = GetRegion(j);
 				} else {
 					reg->neighbors[i] = 0;
 				}
@@ -2520,11 +2571,21 @@ int ARegionList::ReadRegions(Ainfile * f,AList * factions, ATL_VER v) {
 	return 1;
 }
 
+void ARegionList::Add(ARegion *r) {
+	AList::Add(r);
+	numIndex.SetRegion(r->num, r);
+	if (r->gate > 0) gateIndex.SetRegion(r->gate, r);
+}
+
+char ARegionList::Remove(ARegion *r) {
+	if (numIndex.GetRegion(r->num) == r) numIndex.SetRegion(r->num, 0);
+	if (r->gate > 0 && gateIndex.GetRegion(r->gate) == r)
+		gateIndex.SetRegion(r->gate, 0);
+	return AList::Remove(r);
+}
+
 ARegion * ARegionList::GetRegion(int n) {
-	forlist(this) {
-		if (((ARegion *) elem)->num == n) return ((ARegion *) elem);
-	}
-	return 0;
+	return numIndex.GetRegion(n);
 }
 
 ARegion *ARegionList::GetRegion(int x, int y, int z) {
@@ -2540,23 +2601,13 @@ ARegion *ARegionList::GetRegion(int x, int y, int z) {
 }
 
 Location * ARegionList::FindUnit(int i) {
-	forlist(this) {
-		ARegion * reg = (ARegion *) elem;
-		forlist((&reg->objects)) {
-			Object * obj = (Object *) elem;
-			forlist((&obj->units)) {
-				Unit * u = (Unit *) elem;
-				if (u->num == i) {
-					Location * retval = new Location;
-					retval->unit = u;
-					retval->region = reg;
-					retval->obj = obj;
-					return retval;
-				}
-			}
-		}
-	}
-	return 0;
+	Unit *u = GetLiveUnit(i);
+	if (!u || !u->object) return 0;
+	Location * retval = new Location;
+	retval->unit = u;
+	retval->region = u->object->region;
+	retval->obj = u->object;
+	return retval;
 }
 
 void ARegionList::NeighSetup(ARegion * r,ARegionArray * ar) {
@@ -3427,6 +3478,43 @@ void ARegionList::CalcDensities() {
 	Awrite("");
 }
 
+ARegionSector::ARegionSector() {
+	wmons = 0;
+	wanted = 0;
+}
+
+//
+// Put each region in its sector and total up the sectors.  Regions past
+// the last whole sector of a level are in none.
+//
+void ARegionList::SetupSectors() {
+	for (int level = 0; level < numLevels; level++) {
+		ARegionArray *pArr = pRegionArrays[level];
+		delete [] pArr->sectors;
+		pArr->xsecs = pArr->x / 8;
+		pArr->ysecs = pArr->y / 16;
+		pArr->sectors = new ARegionSector[pArr->xsecs * pArr->ysecs + 1];
+	}
+
+	forlist(this) {
+		ARegion *reg = (ARegion *) elem;
+		ARegionArray *pArr = pRegionArrays[reg->zloc];
+		int xsec = reg->xloc / 8;
+		int ysec = reg->yloc / 16;
+		reg->sector = 0;
+		reg->wmonfreq = 0;
+		if (xsec >= pArr->xsecs || ysec >= pArr->ysecs) continue;
+
+		reg->wmonfreq = reg->WMonFreq();
+		reg->sector = &pArr->sectors[xsec + ysec * pArr->xsecs];
+		if (!reg->guards) {
+			reg->sector->wmons += reg->wmons;
+			reg->sector->wanted += reg->wmonfreq;
+		}
+	}
+	sectorsReady = 1;
+}
+
 //****************************************************************************//
 // Create the exits from nexus regions.                                       //
 //      SetACNeighbors is called from world.cpp                               //
@@ -3554,7 +3642,7 @@ void ARegionList::FinalSetupGates() {
 				index++;
 				index = index % numberofgates;
 			}
-			r->gate = index+1;
+			SetGate(r, index+1);
 			used[index] = 1;
 		}
 	}
@@ -3562,12 +3650,29 @@ void ARegionList::FinalSetupGates() {
 }
 
 ARegion *ARegionList::FindGate(int x) {
-	if (!x) return 0;
+	if (x <= 0) return 0;
+	ARegion *r = gateIndex.GetRegion(x);
+	if (r && r->gate != x) {
+		// Somebody changed a gate without going through SetGate
+		IndexGates();
+		r = gateIndex.GetRegion(x);
+	}
+	return r;
+}
+
+void ARegionList::SetGate(ARegion *r, int x) {
+	if (r->gate > 0 && gateIndex.GetRegion(r->gate) == r)
+		gateIndex.SetRegion(r->gate, 0);
+	r->gate = x;
+	if (x > 0) gateIndex.SetRegion(x, r);
+}
+
+void ARegionList::IndexGates() {
+	gateIndex.Clear();
 	forlist(this) {
 		ARegion *r = (ARegion *) elem;
-		if (r->gate == x) return r;
+		if (r->gate > 0) gateIndex.SetRegion(r->gate, r);
 	}
-	return 0;
 }
 
 int ARegionList::GetPlanarDistance(ARegion *one, ARegion *two, int penalty) {
@@ -3587,11 +3692,12 @@ int ARegionList::GetPlanarDistance(ARegion *one, ARegion *two, int penalty) {
 	int maxy;
 	ARegionArray *pArr=pRegionArrays[ARegionArray::LEVEL_SURFACE];
 
-	one_x = one->xloc * GetLevelXScale(one->zloc);
-	one_y = one->yloc * GetLevelYScale(one->zloc);
+	if (!xscale) SetupScales();
+	one_x = one->xloc * xscale[one->zloc];
+	one_y = one->yloc * yscale[one->zloc];
 
-	two_x = two->xloc * GetLevelXScale(two->zloc);
-	two_y = two->yloc * GetLevelYScale(two->zloc);
+	two_x = two->xloc * xscale[two->zloc];
+	two_y = two->yloc * yscale[two->zloc];
 
 	maxy = one_y - two_y;
 	if (maxy < 0) maxy=-maxy;
@@ -3643,11 +3749,25 @@ int ARegionList::GetDistance(ARegion *one,ARegion *two) {
 	return maxx;
 }
 
+void ARegionList::SetupScales() {
+	xscale = new int[numLevels];
+	yscale = new int[numLevels];
+	for (int i = 0; i < numLevels; i++) {
+		xscale[i] = GetLevelXScale(i);
+		yscale[i] = GetLevelYScale(i);
+	}
+}
+
 ARegionArray *ARegionList::GetRegionArray(int level) {
 	return(pRegionArrays[ level ]);
 }
 
 void ARegionList::CreateLevels(int n) {
+	delete [] xscale;
+	delete [] yscale;
+	xscale = 0;
+	yscale = 0;
+	sectorsReady = 0;
 	numLevels = n;
 	pRegionArrays = new ARegionArray *[ n ];
 }
@@ -3657,6 +3777,9 @@ ARegionArray::ARegionArray(int xx,int yy) {
 	y = yy;
 	regions = new ARegion *[x * y / 2 + 1];
 	strName = 0;
+	xsecs = 0;
+	ysecs = 0;
+	sectors = 0;
 
 	int i;
 	for(i = 0; i < x * y / 2; i++) regions[i] = 0;
@@ -3665,6 +3788,7 @@ ARegionArray::ARegionArray(int xx,int yy) {
 ARegionArray::~ARegionArray() {
 	if (strName) delete strName;
 	delete [] regions;
+	delete [] sectors;
 }
 
 void ARegionArray::SetRegion(int xx,int yy,ARegion * r) {
@@ -3689,17 +3813,38 @@ void ARegionArray::SetName(char *name) {
 
 ARegionFlatArray::ARegionFlatArray(int s) {
 	size = s;
-	regions = new ARegion *[s];
+	regions = 0;
+	if (size) {
+		regions = new ARegion *[size];
+		for (int i = 0; i < size; i++) regions[i] = 0;
+	}
 }
 
 ARegionFlatArray::~ARegionFlatArray() {
-	if (regions) delete regions;
+	if (regions) delete [] regions;
 }
 
 void ARegionFlatArray::SetRegion(int x,ARegion * r) {
+	if (x < 0) return;
+	if (x >= size) {
+		int newsize = size ? size * 2 : 64;
+		while (newsize <= x) newsize *= 2;
+		ARegion **temp = new ARegion *[newsize];
+		int i;
+		for (i = 0; i < size; i++) temp[i] = regions[i];
+		for (; i < newsize; i++) temp[i] = 0;
+		if (regions) delete [] regions;
+		regions = temp;
+		size = newsize;
+	}
 	regions[x] = r;
 }
 
 ARegion * ARegionFlatArray::GetRegion(int x) {
+	if (x < 0 || x >= size) return 0;
 	return regions[x];
 }
+
+void ARegionFlatArray::Clear() {
+	for (int i = 0; i < size; i++) regions[i] = 0;
+}
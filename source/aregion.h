@@ -28,6 +28,7 @@
 
 class ARegion;
 class ARegionList;
+class ARegionSector;
 
 #include "gamedefs.h"
 #include "gameio.h"
@@ -122,6 +123,24 @@ class Farsight : public AListElem {
 
 Farsight *GetFarsight(AList *,Faction *);
 
+//
+// The best observation, true seeing and scouting among a faction's units
+// in a region, and their best mind reading.  Each region keeps one of
+// these per faction present, and rebuilds them the next time they are
+// asked for after InvalidateVision() has been called.
+//
+class FactionVision : public AListElem {
+	public:
+		Faction *faction;
+		int observation;
+		int truesight;
+		int scout;
+		int mindreading;
+};
+
+/* Call whenever a unit's skills, items, faction or location change */
+void InvalidateVision();
+
 enum {
 	TOWN_VILLAGE,
 	TOWN_TOWN,
@@ -190,6 +209,8 @@ class ARegion : public AListElem {
 		int GetScout(Faction *, int);
 		int GetObservation(Faction *, int);
 		int GetTrueSight(Faction *, int);
+		FactionVision *GetVision(Faction *);
+		void UpdateVision();
 
 		Object * GetObject(int);
 		Object * GetDummy();
@@ -236,6 +257,9 @@ class ARegion : public AListElem {
 
 		int CountWMons();
 		int IsGuarded();
+		void CountUnit(Unit *, int);
+		int WMonFreq();
+		void SetType(int);
 
 		int Wages();
 		AString WagesForReport();
@@ -266,6 +290,20 @@ class ARegion : public AListElem {
 		AList farsees;
 		// List of units which passed through the region
 		AList passers;
+		AList vision; /* FactionVision for each faction present */
+		int visionstamp;
+
+		//
+		// The wandering monsters and guarding units here, kept up to date
+		// by CountUnit as units arrive, leave or change their guard.  The
+		// sector is the GrowWMons sector the region is in, if any, and
+		// wmonfreq what the region adds to the monsters it wants.  Change
+		// the terrain with SetType so wmonfreq follows it.
+		//
+		int wmons;
+		int guards;
+		ARegionSector *sector;
+		int wmonfreq;
 		ProductionList products;
 		MarketList markets;
 		int xloc,yloc,zloc;
@@ -295,6 +333,11 @@ class ARegionArray {
 		ARegion ** regions;
 		AString *strName;
 
+		/* The 8 by 16 sectors of the level, xsecs across and ysecs down */
+		int xsecs;
+		int ysecs;
+		ARegionSector *sectors;
+
 		enum {
 			LEVEL_NEXUS,
 			LEVEL_SURFACE,
@@ -304,23 +347,44 @@ class ARegionArray {
 		int levelType;
 };
 
+//
+// A dense table of regions by number, growing as needed.  Out of range
+// lookups return 0.
+//
 class ARegionFlatArray {
 	public:
-		ARegionFlatArray(int);
+		ARegionFlatArray(int = 0);
 		~ARegionFlatArray();
 
 		void SetRegion(int,ARegion *);
 		ARegion * GetRegion(int);
+		void Clear();
 
 		int size;
 		ARegion ** regions;
 };
 
+//
+// Wandering monsters are grown sector by sector.  Each sector keeps the
+// totals GrowWMons needs over its unguarded regions, which the regions
+// update as their own counts change.
+//
+class ARegionSector {
+	public:
+		ARegionSector();
+
+		int wmons;
+		int wanted;	/* sum of wmonfreq */
+};
+
 class ARegionList : public AList {
 	public:
 		ARegionList();
 		~ARegionList();
 
+		void Add(ARegion *);
+		char Remove(ARegion *);
+
 		ARegion * GetRegion(int);
 		ARegion * GetRegion(int,int,int);
 		int ReadRegions(Ainfile *f, AList *, ATL_VER v);
@@ -332,6 +396,7 @@ class ARegionList : public AList {
 				int maxY);
 
 		ARegion *FindGate(int);
+		void SetGate(ARegion *, int);
 		int GetDistance(ARegion *,ARegion *);
 		int GetPlanarDistance(ARegion *,ARegion *, int penalty);
 		int GetWeather(ARegion *pReg, int month);
@@ -368,10 +433,28 @@ class ARegionList : public AList {
 		void SeverLandBridges(ARegionArray *pRegs);
 
 		void CalcDensities();
+		void SetupSectors();
+		int sectorsReady;
 		int GetLevelXScale(int level);
 		int GetLevelYScale(int level);
 
 	private:
+		//
+		// Lookup tables for GetRegion(int) and FindGate, kept up to date
+		// by Add, Remove and SetGate.
+		//
+		ARegionFlatArray numIndex;
+		ARegionFlatArray gateIndex;
+		void IndexGates();
+
+		//
+		// GetLevelXScale and GetLevelYScale for each level, made when
+		// first used.
+		//
+		int *xscale;
+		int *yscale;
+		void SetupScales();
+
 		//
 		// Private world creation stuff
 		//
@@ -33,6 +33,8 @@
 #include "army.h"
 #include "gameio.h"
 #include <gamedata.h>
+#include <new>
+#include <string.h>
 
 enum {
 	WIN_NO_DEAD,
@@ -40,11 +42,25 @@ enum {
 	LOSS
 };
 
-Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
+Soldier::Soldier(Army *a,int s,Unit * u,Object * o,int regtype,int r,int ass) {
+	army = a;
+	slot = s;
 	race = r;
 	unit = u;
 	building = 0;
 
+	short &armor = a->armor[s];
+	short &shield = a->shield[s];
+	short &riding = a->riding[s];
+	short &weapon = a->weapon[s];
+	int &mount = a->mount[s];
+	int &attacks = a->attacks[s];
+	int &askill = a->askill[s];
+	short *dskill = a->dskill + s * NUM_ATTACK_TYPES;
+	int &damage = a->damage[s];
+	int &hits = a->hits[s];
+	int &maxhits = a->maxhits[s];
+
 	healing = 0;
 	healtype = 0;
 	healitem = -1;
@@ -55,8 +71,7 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 	shield = -1;
 	riding = -1;
 	weapon = -1;
-	mount = 0;
-	rider = 0;
+	mount = -1;
 
 	amulet = -1;
 	ring1 = -1;
@@ -80,10 +95,10 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 	damage = 0;
 	hits = 1;
 	maxhits = 1;
-	amuletofi = 0;
+	a->amuletofi[s] = 0;
 	battleItems = 0;
 
-	effects = 0;
+	a->effects[s] = 0;
 
 	int debug=0;
 //	if( u->num == 62 ) debug = 1;
@@ -111,11 +126,6 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 		int mon = ItemDefs[r].index;
 		if( ItemDefs[r].type & IT_MOUNT ) 
 			mon = MountDefs[mon].monster;
-		if (u->type == U_WMON)
-			name = AString(MonDefs[mon].name) + " in " + *(unit->name);
-		else
-			name = AString(MonDefs[mon].name) +
-				AString(" controlled by ") + *(unit->name);
 		askill = MonDefs[mon].attackLevel;
 		dskill[ATTACK_COMBAT] += MonDefs[mon].defense[ATTACK_COMBAT];
 		if (MonDefs[mon].defense[ATTACK_ENERGY] > dskill[ATTACK_ENERGY]) {
@@ -144,10 +154,8 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 		return;
 	}
 
-	name = *(unit->name);
-
 	if( debug ) {
-		Awrite( AString( "New Soldier from" ) + name );
+		Awrite( AString( "New Soldier from" ) + Name() );
 	}
 
 	SetupHealing();
@@ -204,8 +212,9 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 			dskill[ATTACK_RIDING] += ridingBonus;
 			riding = item;
 			if( MountDefs[ItemDefs[riding].index].monster != -1 ) {
-				mount = new Soldier( u, o, regtype, riding, ass );
-				mount->rider = this;
+				mount = s + a->count;
+				new (&a->pool[mount]) Soldier( a, mount, u, o, regtype, riding,
+						ass );
 			}
 
 			break;
@@ -221,8 +230,9 @@ Soldier::Soldier(Unit * u,Object * o,int regtype,int r,int ass) {
 				dskill[ATTACK_RIDING] += ridingBonus;
 				riding = item;
 				if( MountDefs[ItemDefs[riding].index].monster != -1 ) {
-					mount = new Soldier( u, o, regtype, riding, ass );
-					mount->rider = this;
+					mount = s + a->count;
+					new (&a->pool[mount]) Soldier( a, mount, u, o, regtype, riding,
+							ass );
 				}
 
 				break;
@@ -397,6 +407,7 @@ void Soldier::SetupSpell() {
 }
 
 void Soldier::SetupCombatItems() {
+	short *dskill = army->dskill + slot * NUM_ATTACK_TYPES;
 	int battleType;
 	for (battleType = 1; battleType < NUMBATTLEITEMS; battleType++) {
 		BattleItemType *pBat = &BattleItemDefs[ battleType ];
@@ -441,7 +452,7 @@ void Soldier::SetupCombatItems() {
 
 			/* Make sure amulets of invulnerability are marked */
 			if (item == I_AMULETOFI) {
-				amuletofi = 1;
+				army->amuletofi[slot] = 1;
 			}
 
 			if( pBat->index == -1 && pBat->bonusType == -1 ) {
@@ -478,16 +489,16 @@ void Soldier::SetupCombatItems() {
 
 				// Add bonuses
 				if( pBat->bonusType & BattleItemType::ADD_ATTACK )
-					askill += pBat->bonusAmount;
+					army->askill[slot] += pBat->bonusAmount;
 
 				if( pBat->bonusType & BattleItemType::ADD_DEFENSE )
 					dskill[ATTACK_COMBAT] += pBat->bonusAmount;
 
 				if( pBat->bonusType & BattleItemType::ADD_HITS )
-					hits += pBat->bonusAmount;
+					army->hits[slot] += pBat->bonusAmount;
 
 				if( pBat->bonusType & BattleItemType::ADD_ATTACKS )
-					attacks += pBat->bonusAmount;
+					army->attacks[slot] += pBat->bonusAmount;
 
 				// Add to soldier's item slot
 				if( pBat->flags & BattleItemType::AMULET ) {
@@ -513,61 +524,83 @@ void Soldier::SetupCombatItems() {
 	}
 }
 
-int Soldier::HasEffect(int eff) {
+int Army::HasEffect(int s, int eff) {
 	if (eff < 0) return 0;
 	int n = 1 << eff;
-	return (effects & n);
+	return (effects[s] & n);
 }
 
-void Soldier::SetEffect(int eff) {
+void Army::SetEffect(int s, int eff) {
 	if (eff < 0) return;
 	int n = 1 << eff;
 	int i;
 
 	EffectType *e = &EffectDefs[eff];
 
-	askill += e->attackVal;
+	askill[s] += e->attackVal;
 
 	for (i = 0; i < 4; i++) {
 		if (e->defMods[i].type != -1) {
-			dskill[e->defMods[i].type] += e->defMods[i].val;
+			dskill[s * NUM_ATTACK_TYPES + e->defMods[i].type] +=
+				e->defMods[i].val;
 		}
 	}
 
 	if (e->cancelEffect != -1) {
-		ClearEffect(e->cancelEffect);
+		ClearEffect(s, e->cancelEffect);
 	}
 
 	if (!(e->flags & EffectType::EFF_NOSET)) {
-		effects = effects | n;
+		effects[s] = effects[s] | n;
 	}
 }
 
-void Soldier::ClearEffect(int eff) {
+void Army::ClearEffect(int s, int eff) {
 	if (eff < 0) return;
 	int n = 1 << eff;
 	int i;
 
 	EffectType *e = &EffectDefs[eff];
 
-	askill -= e->attackVal;
+	askill[s] -= e->attackVal;
 
 	for (i = 0; i < 4; i++) {
 		if (e->defMods[i].type != -1) {
-			dskill[e->defMods[i].type] -= e->defMods[i].val;
+			dskill[s * NUM_ATTACK_TYPES + e->defMods[i].type] -=
+				e->defMods[i].val;
 		}
 	}
-	effects &= ~n;
+	effects[s] &= ~n;
 }
 
-void Soldier::ClearOneTimeEffects(void) {
+void Army::ClearOneTimeEffects(int s) {
 	for (int i = 0; i < NUMEFFECTS; i++) {
-		if (HasEffect(i) && (EffectDefs[i].flags & EffectType::EFF_ONESHOT))
-			ClearEffect(i);
+		if (HasEffect(s, i) && (EffectDefs[i].flags & EffectType::EFF_ONESHOT))
+			ClearEffect(s, i);
+	}
+}
+
+RandomBlock::RandomBlock() {
+	left = 0;
+}
+
+int RandomBlock::Get(int range) {
+	if (!range) return 0;
+	if (!left) {
+		getrandomwords(words, ATTACK_BATCH);
+		left = ATTACK_BATCH;
 	}
+	unsigned long i = words[--left];
+	if (range < 0) return -(int)(i % -range);
+	return (int)(i % range);
 }
 
-int Soldier::ArmorProtect(int weaponClass) {
+static int Draw(RandomBlock *rb, int range) {
+	if (rb) return rb->Get(range);
+	return getrandom(range);
+}
+
+static int ArmorProtect(int armor, int shield, int weaponClass, RandomBlock *rb) {
 	//
 	// Return 1 if the armor is successful
 	//
@@ -578,18 +611,23 @@ int Soldier::ArmorProtect(int weaponClass) {
 	ArmorType *pArm = &ArmorDefs[armorType];
 	int chance = pArm->saves[weaponClass];
 
-	if (chance > getrandom(pArm->from)) return 1;
+	if (chance > Draw(rb, pArm->from)) return 1;
 	if (shield > 0) {
 		armorType = ItemDefs[shield].index;
 		pArm = &ArmorDefs[armorType];
 		chance = pArm->saves[weaponClass];
-		if (chance > getrandom(pArm->from)) return 1;
+		if (chance > Draw(rb, pArm->from)) return 1;
 	}
 
 	return 0;
 }
 
 void Soldier::RestoreItems() {
+	int weapon = army->weapon[slot];
+	int armor = army->armor[slot];
+	int shield = army->shield[slot];
+	int riding = army->riding[slot];
+
 	if (healing && healitem != -1) {
 		if (healitem == I_HEALINGPOTION) {
 			unit->items.SetNum(healitem,
@@ -631,9 +669,9 @@ void Soldier::Alive(int state) {
 	if (state == LOSS) {
 		unit->canattack = 0;
 		/* Guards with amuletofi will not go off guard */
-		if (!amuletofi &&
+		if (!army->amuletofi[slot] &&
 			(unit->guard == GUARD_GUARD || unit->guard == GUARD_SET)) {
-			unit->guard = GUARD_NONE;
+			unit->SetGuard(GUARD_NONE);
 		}
 	} else {
 		unit->advancefrom = 0;
@@ -651,6 +689,19 @@ void Soldier::Dead() {
 	unit->SetMen(race,unit->GetMen(race) - 1);
 }
 
+AString Soldier::Name() {
+	if (ItemDefs[race].type & IT_MONSTER || ItemDefs[race].type & IT_MOUNT) {
+		int mon = ItemDefs[race].index;
+		if( ItemDefs[race].type & IT_MOUNT )
+			mon = MountDefs[mon].monster;
+		if (unit->type == U_WMON)
+			return AString(MonDefs[mon].name) + " in " + *(unit->name);
+		return AString(MonDefs[mon].name) +
+			AString(" controlled by ") + *(unit->name);
+	}
+	return *(unit->name);
+}
+
 Army::Army(Unit * ldr,AList * locs,int regtype,int ass) {
 	int tacspell = 0;
 	Unit * tactitian = ldr;
@@ -678,7 +729,25 @@ Army::Army(Unit * ldr,AList * locs,int regtype,int ass) {
 	}
 	tactitian->Practise(S_TACTICS);
 
-	soldiers = new SoldierPtr[count];
+	//
+	// Room for every soldier and for a mount behind each of them.
+	//
+	int slots = 2 * count;
+	soldiers = new int[count];
+	pool = (Soldier *) ::operator new(slots * sizeof(Soldier));
+	hits = new int[slots];
+	maxhits = new int[slots];
+	damage = new int[slots];
+	weapon = new short[slots];
+	armor = new short[slots];
+	shield = new short[slots];
+	riding = new short[slots];
+	mount = new int[slots];
+	amuletofi = new char[slots];
+	askill = new int[slots];
+	attacks = new int[slots];
+	effects = new int[slots];
+	dskill = new short[slots * NUM_ATTACK_TYPES];
 	int x = 0;
 	int y = count;
 
@@ -690,9 +759,10 @@ Army::Army(Unit * ldr,AList * locs,int regtype,int ass) {
 				Item * it = (Item *) elem;
 				if (it) {
 					if (ItemDefs[ it->type ].type & IT_MAN) {
-							soldiers[x] = new Soldier(u, obj, regtype,
-									it->type, ass);
-							hitstotal = soldiers[x]->hits;
+							soldiers[x] = x;
+							new (&pool[x]) Soldier(this, x, u, obj,
+									regtype, it->type, ass);
+							hitstotal = hits[x];
 							++x;
 							goto finished_army;
 					}
@@ -706,13 +776,15 @@ Army::Army(Unit * ldr,AList * locs,int regtype,int ass) {
 						if ((ItemDefs[ it->type ].type & IT_MAN) &&
 								u->GetFlag(FLAG_BEHIND)) {
 							--y;
-							soldiers[y] = new Soldier(u, obj, regtype,
-									it->type);
-							hitstotal += soldiers[y]->hits;
+							soldiers[y] = y;
+							new (&pool[y]) Soldier(this, y, u, obj,
+									regtype, it->type);
+							hitstotal += hits[y];
 						} else {
-							soldiers[x] = new Soldier(u, obj, regtype,
-									it->type);
-							hitstotal += soldiers[x]->hits;
+							soldiers[x] = x;
+							new (&pool[x]) Soldier(this, x, u, obj,
+									regtype, it->type);
+							hitstotal += hits[x];
 							++x;
 						}
 					}
@@ -748,7 +820,25 @@ finished_army:
 }
 
 Army::~Army() {
+	//
+	// Soldiers and their mounts hold no resources of their own, so the
+	// pool is released in one go.
+	//
+	::operator delete(pool);
 	delete [] soldiers;
+	delete [] hits;
+	delete [] maxhits;
+	delete [] damage;
+	delete [] weapon;
+	delete [] armor;
+	delete [] shield;
+	delete [] riding;
+	delete [] mount;
+	delete [] amuletofi;
+	delete [] askill;
+	delete [] attacks;
+	delete [] effects;
+	delete [] dskill;
 }
 
 void Army::Reset() {
@@ -772,9 +862,9 @@ void Army::WriteLosses(Battle * b) {
 	if (notbehind != count) {
 		AList units;
 		for (int i=notbehind; i<count; i++) {
-			if (!GetUnitList(&units,soldiers[i]->unit)) {
+			if (!GetUnitList(&units,pool[soldiers[i]].unit)) {
 				UnitPtr *u = new UnitPtr;
-				u->ptr = soldiers[i]->unit;
+				u->ptr = pool[soldiers[i]].unit;
 				units.Add(u);
 			}
 		}
@@ -863,28 +953,29 @@ void Army::GetMonSpoils(ItemList *spoils,int monitem, int free) {
 
 void Army::Regenerate(Battle *b) {
 	for (int i = 0; i < count; i++) {
-		Soldier *s = soldiers[i];
+		int t = soldiers[i];
+		Soldier *s = &pool[t];
 		if (i<notbehind) {
-			int diff = s->maxhits - s->hits;
+			int diff = maxhits[t] - hits[t];
 			if (diff > 0) {
-				AString aName = s->name;
+				AString aName = s->Name();
 
-				if (s->damage != 0) {
-					b->AddLine(aName + " takes " + s->damage +
-							" hits bringing it to " + s->hits + "/" +
-							s->maxhits + ".");
-					s->damage = 0;
+				if (damage[t] != 0) {
+					b->AddLine(aName + " takes " + damage[t] +
+							" hits bringing it to " + hits[t] + "/" +
+							maxhits[t] + ".");
+					damage[t] = 0;
 				} else {
 					b->AddLine(aName + " takes no hits leaving it at " +
-							s->hits + "/" + s->maxhits + ".");
+							hits[t] + "/" + maxhits[t] + ".");
 				}
 				if (s->regen) {
 					int regen = s->regen;
 					if (regen > diff) regen = diff;
-					s->hits += regen;
+					hits[t] += regen;
 					b->AddLine(aName + " regenerates " + regen +
-							" hits bringing it to " + s->hits + "/" +
-							s->maxhits + ".");
+							" hits bringing it to " + hits[t] + "/" +
+							maxhits[t] + ".");
 				}
 			}
 		}
@@ -894,7 +985,7 @@ void Army::Regenerate(Battle *b) {
 void Army::Lose(Battle *b,ItemList *spoils) {
 	WriteLosses(b);
 	for (int i=0; i<count; i++) {
-		Soldier * s = soldiers[i];
+		Soldier * s = &pool[soldiers[i]];
 		if (i<notbehind) {
 			s->Alive(LOSS);
 		} else {
@@ -902,26 +993,24 @@ void Army::Lose(Battle *b,ItemList *spoils) {
 				GetMonSpoils(spoils,s->race,s->unit->free);
 			s->Dead();
 		}
-		delete s;
 	}
 }
 
 void Army::Tie(Battle * b) {
 	WriteLosses(b);
 	for (int x=0; x<count; x++) {
-		Soldier * s = soldiers[x];
+		Soldier * s = &pool[soldiers[x]];
 		if (x<NumAlive()) {
 			s->Alive(WIN_DEAD);
 		} else {
 			s->Dead();
 		}
-		delete s;
 	}
 }
 
 int Army::CanBeHealed() {
 	for (int i=notbehind; i<count; i++) {
-		Soldier * temp = soldiers[i];
+		Soldier * temp = &pool[soldiers[i]];
 		if (temp->canbehealed) return 1;
 	}
 	return 0;
@@ -937,7 +1026,7 @@ void Army::DoHeal(Battle * b) {
 
 void Army::DoHealLevel(Battle *b, int type, int useItems) {
 	for (int i=0; i<NumAlive(); i++) {
-		Soldier * s = soldiers[i];
+		Soldier * s = &pool[soldiers[i]];
 		int n = 0;
 		if (!CanBeHealed()) break;
 		if (s->healtype <= 0) continue;
@@ -961,13 +1050,14 @@ void Army::DoHealLevel(Battle *b, int type, int useItems) {
 		while (s->healing) {
 			if (!CanBeHealed()) break;
 			int j = getrandom(count - NumAlive()) + notbehind;
-			Soldier * temp = soldiers[j];
+			int t = soldiers[j];
+			Soldier * temp = &pool[t];
 			if (temp->canbehealed) {
 				s->healing--;
 				if (getrandom(100) < rate) {
 					n++;
 					soldiers[j] = soldiers[notbehind];
-					soldiers[notbehind] = temp;
+					soldiers[notbehind] = t;
 					notbehind++;
 				} else
 					temp->canbehealed = 0;
@@ -998,7 +1088,7 @@ void Army::Win(Battle * b,ItemList * spoils) {
 
 			// Make a list of units who can get this type of spoil
 			for (int x = 0; x < na; x++) {
-				u = soldiers[x]->unit;
+				u = pool[soldiers[x]].unit;
 				if (u->CanGetSpoil(i)) {
 					up = new UnitPtr;
 					up->ptr = u;
@@ -1096,10 +1186,9 @@ void Army::Win(Battle * b,ItemList * spoils) {
 	}
 
 	for (int x = 0; x < count; x++) {
-		Soldier * s = soldiers[x];
+		Soldier * s = &pool[soldiers[x]];
 		if (x<NumAlive()) s->Alive(wintype);
 		else s->Dead();
-		delete s;
 	}
 }
 
@@ -1116,7 +1205,7 @@ int Army::NumSpoilers() {
 	int na = NumAlive();
 	int count = 0;
 	for (int x=0; x<na; x++) {
-		Unit * u = soldiers[x]->unit;
+		Unit * u = pool[soldiers[x]].unit;
 		if (!(u->flags & FLAG_NOSPOILS)) count++;
 	}
 	return count;
@@ -1142,16 +1231,16 @@ int Army::NumFrontHits() {
 	int totHits = 0;
 
 	for (int i = 0; i < canfront; i++) {
-		totHits += soldiers[i]->maxhits;
+		totHits += maxhits[soldiers[i]];
 	}
 	for (int i = canbehind; i < notfront; i++) {
-		totHits += soldiers[i]->maxhits;
+		totHits += maxhits[soldiers[i]];
 	}
 	return totHits;
 }
 
 Soldier * Army::GetAttacker(int i,int &behind) {
-	Soldier * retval = soldiers[i];
+	int retval = soldiers[i];
 	if (i<canfront) {
 		soldiers[i] = soldiers[canfront-1];
 		soldiers[canfront-1] = soldiers[canbehind-1];
@@ -1159,7 +1248,7 @@ Soldier * Army::GetAttacker(int i,int &behind) {
 		canfront--;
 		canbehind--;
 		behind = 0;
-		return retval;
+		return &pool[retval];
 	}
 	soldiers[i] = soldiers[canbehind-1];
 	soldiers[canbehind-1] = soldiers[notfront-1];
@@ -1167,10 +1256,10 @@ Soldier * Army::GetAttacker(int i,int &behind) {
 	canbehind--;
 	notfront--;
 	behind = 1;
-	return retval;
+	return &pool[retval];
 }
 
-int Army::GetTargetNum(int special, int canAttackBehind) {
+int Army::GetTargetNum(int special, int canAttackBehind, RandomBlock *rb) {
 	int tars = NumFront();
 	if (canAttackBehind) {
 		//tars += NumAlive();
@@ -1202,7 +1291,7 @@ int Army::GetTargetNum(int special, int canAttackBehind) {
 			}
 		}
 		if (validtargs) {
-			int targ = getrandom(validtargs);
+			int targ = Draw(rb, validtargs);
 			for (i = start; i < notfront; i++) {
 				if (i == canfront) i = canbehind;
 				if (CheckSpecialTarget(special, i)) {
@@ -1211,7 +1300,7 @@ int Army::GetTargetNum(int special, int canAttackBehind) {
 			}
 		}
 	} else {
-		int i = getrandom(tars);
+		int i = Draw(rb, tars);
 		if (canAttackBehind) {
 			return i;
 		} else {
@@ -1227,14 +1316,14 @@ int Army::GetEffectNum(int effect) {
 	int i, start = -1;
 
 	for (i = 0; i < canfront; i++) {
-		if (soldiers[i]->HasEffect(effect)) {
+		if (HasEffect(soldiers[i], effect)) {
 			validtargs++;
 			// slight scan optimisation - skip empty initial sequences
 			if (start == -1) start = i;
 		}
 	}
 	for (i = canbehind; i < notfront; i++) {
-		if (soldiers[i]->HasEffect(effect)) {
+		if (HasEffect(soldiers[i], effect)) {
 			validtargs++;
 			// slight scan optimisation - skip empty initial sequences
 			if (start == -1) start = i;
@@ -1244,7 +1333,7 @@ int Army::GetEffectNum(int effect) {
 		int targ = getrandom(validtargs);
 		for (i = start; i < notfront; i++) {
 			if (i == canfront) i = canbehind;
-			if (soldiers[i]->HasEffect(effect)) {
+			if (HasEffect(soldiers[i], effect)) {
 				if (!targ--) return i;
 			}
 		}
@@ -1253,7 +1342,7 @@ int Army::GetEffectNum(int effect) {
 }
 
 Soldier * Army::GetTarget(int i) {
-	return soldiers[i];
+	return &pool[soldiers[i]];
 }
 
 int pow(int b,int p) {
@@ -1264,14 +1353,14 @@ int pow(int b,int p) {
 	return b2;
 }
 
-int Hits(int a,int d) {
+int Hits(int a,int d,RandomBlock *rb = 0) {
 	int tohit = 1,tomiss = 1;
 	if (a>d) {
 		tohit = pow(2,a-d);
 	} else if (d>a) {
 		tomiss = pow(2,d-a);
 	}
-	if (getrandom(tohit+tomiss) < tohit) return 1;
+	if (Draw(rb, tohit+tomiss) < tohit) return 1;
 	return 0;
 }
 
@@ -1283,12 +1372,10 @@ int Army::RemoveEffects(int num, int effect) {
 		//
 		int tarnum = GetEffectNum(effect);
 		if (tarnum == -1) continue;
-		Soldier *tar = GetTarget(tarnum);
-
 		//
 		// Remove the effect
 		//
-		tar->ClearEffect(effect);
+		ClearEffect(soldiers[tarnum], effect);
 		ret++;
 	}
 	return(ret);
@@ -1344,158 +1431,267 @@ int Army::DoAnAttack(int special, int numAttacks, int attackType,
 		/* 3. Get the target */
 		int tarnum = GetTargetNum(special,attackbehind);
 		if (tarnum == -1) continue;
-		Soldier * tar = GetTarget(tarnum);
 
-//		if( tar->unit->num == 62 && special ) debug = 1;
+//		if( GetTarget(tarnum)->unit->num == 62 && special ) debug = 1;
 		if( debug ) {
-			Awrite( AString( "Attack against " ) + tar->name + "; askill " + attackLevel +
-				"; attackBehind " + attackbehind + "; attack type " + attackType + "." );
-		}
-		// 3.1  50% chance of attacking mount
-		if( tar->mount ) {
-			if( getrandom(2) ) {
-				// attack mount
-				if( debug ) Awrite( "- Attacking mount instead of rider." );
-				tar = tar->mount;
-			}
-		}
-		int tarFlags = 0;
-		if (tar->weapon != -1) {
-			tarFlags = WeaponDefs[ItemDefs[tar->weapon].index].flags;
+			Awrite( AString( "Attack against " ) + GetTarget(tarnum)->Name() +
+				"; askill " + attackLevel + "; attackBehind " + attackbehind +
+				"; attack type " + attackType + "." );
 		}
+		ret += ResolveAttack(tarnum, special, attackType, attackLevel, flags,
+				weaponClass, effect, mountBonus, 1, 0);
+	}
+	return ret;
+}
 
-		/* 4. Add in any effects, if applicable */
-		int tlev = 0;
-		if (attackType != NUM_ATTACK_TYPES)
-			tlev = tar->dskill[ attackType ];
-		if (special > 0) {
-			if ((SpecialDefs[special].effectflags&SpecialType::FX_NOBUILDING) &&
-					tar->building) {
-				tlev -= 2;
-			}
+//
+// Resolve one attack against soldier tarnum, returning 1 if it hit or
+// applied its effect.  Weapon length and mount bonuses are added to
+// attackLevel in place, so later attacks of the same DoAnAttack call
+// inherit them.  Without coin the 50% miss chance has already been
+// settled by the caller.
+//
+int Army::ResolveAttack(int tarnum, int special, int attackType,
+		int &attackLevel, int flags, int weaponClass, int effect,
+		int mountBonus, int coin, RandomBlock *rb) {
+	int debug = 0;
+	int t = soldiers[tarnum];
+
+	// 3.1  50% chance of attacking mount
+	if( mount[t] != -1 ) {
+		if( Draw(rb, 2) ) {
+			// attack mount
+			if( debug ) Awrite( "- Attacking mount instead of rider." );
+			t = mount[t];
 		}
-
-		if( debug ) {
-			AString temp = "Defense array: [ ";
-			for( int i = 0; i < NUM_ATTACK_TYPES; i++ ) {
-				temp += tar->dskill[ i ];
-				temp += " ";
-			}
-			temp += " ]";
-			Awrite( temp );
-			Awrite( AString( "- Attacking: " ) + attackLevel + " vs " + tlev + " (first check)." );
+	}
+	// Read what the attack needs of the target together, so that the
+	// loads from the separate arrays overlap.
+	int tarWeapon = weapon[t];
+	int tarRiding = riding[t];
+	int tarArmor = armor[t];
+	int tarShield = shield[t];
+	int tarFlags = 0;
+	if (tarWeapon != -1) {
+		tarFlags = WeaponDefs[ItemDefs[tarWeapon].index].flags;
+	}
+
+	/* 4. Add in any effects, if applicable */
+	int tlev = 0;
+	if (attackType != NUM_ATTACK_TYPES)
+		tlev = dskill[ t * NUM_ATTACK_TYPES + attackType ];
+	if (special > 0) {
+		if ((SpecialDefs[special].effectflags&SpecialType::FX_NOBUILDING) &&
+				pool[t].building) {
+			tlev -= 2;
 		}
+	}
 
-		/* 4.1 Check whether defense is allowed against this weapon */
-		if ((flags & WeaponType::NODEFENSE) && (tlev > 0)) tlev = 0;
-
-		if (!(flags & WeaponType::RANGED)) {
-			/* 4.2 Check relative weapon length */
-			int attLen = 1;
-			int defLen = 1;
-			if (flags & WeaponType::LONG) attLen = 2;
-			else if (flags & WeaponType::SHORT) attLen = 0;
-			if (tarFlags & WeaponType::LONG) defLen = 2;
-			else if (tarFlags & WeaponType::SHORT) defLen = 0;
-			if (attLen > defLen) attackLevel++;
-			else if (defLen > attLen) tlev++;
+	if( debug ) {
+		AString temp = "Defense array: [ ";
+		for( int i = 0; i < NUM_ATTACK_TYPES; i++ ) {
+			temp += dskill[ t * NUM_ATTACK_TYPES + i ];
+			temp += " ";
 		}
+		temp += " ]";
+		Awrite( temp );
+		Awrite( AString( "- Attacking: " ) + attackLevel + " vs " + tlev + " (first check)." );
+	}
 
-		/* 4.3 Add bonuses versus mounted */
-		if (tar->riding != -1) attackLevel += mountBonus;
+	/* 4.1 Check whether defense is allowed against this weapon */
+	if ((flags & WeaponType::NODEFENSE) && (tlev > 0)) tlev = 0;
 
-		if( debug ) {
-			Awrite( AString( "- Attacking: " ) + attackLevel + " vs " + tlev + "." );
-		}
-		/* 5. Attack soldier */
-		if (attackType != NUM_ATTACK_TYPES &&
-			attackType != ATTACK_DISPEL ) {
-			if (!(flags & WeaponType::ALWAYSREADY)) {
-				if (getrandom(2)) {
-					if( debug ) {
-						Awrite( "--Misses!" );
-					}
-					continue;
-				}
-			}
+	if (!(flags & WeaponType::RANGED)) {
+		/* 4.2 Check relative weapon length */
+		int attLen = 1;
+		int defLen = 1;
+		if (flags & WeaponType::LONG) attLen = 2;
+		else if (flags & WeaponType::SHORT) attLen = 0;
+		if (tarFlags & WeaponType::LONG) defLen = 2;
+		else if (tarFlags & WeaponType::SHORT) defLen = 0;
+		if (attLen > defLen) attackLevel++;
+		else if (defLen > attLen) tlev++;
+	}
+
+	/* 4.3 Add bonuses versus mounted */
+	if (tarRiding != -1) attackLevel += mountBonus;
 
-			if (!Hits(attackLevel,tlev)) {
+	if( debug ) {
+		Awrite( AString( "- Attacking: " ) + attackLevel + " vs " + tlev + "." );
+	}
+	/* 5. Attack soldier */
+	if (attackType != NUM_ATTACK_TYPES &&
+		attackType != ATTACK_DISPEL ) {
+		if (coin && !(flags & WeaponType::ALWAYSREADY)) {
+			if (getrandom(2)) {
 				if( debug ) {
-					Awrite( "--Fails to hit!" );
+					Awrite( "--Misses!" );
 				}
-				continue;
+				return 0;
 			}
 		}
-		if( debug ) {
-			Awrite( "--Hits!" );
+
+		if (!Hits(attackLevel,tlev,rb)) {
+			if( debug ) {
+				Awrite( "--Fails to hit!" );
+			}
+			return 0;
 		}
+	}
+	if( debug ) {
+		Awrite( "--Hits!" );
+	}
 
-		/* 6. If attack got through, apply effect, or kill */
-		if (!effect) {
-			/* 7. Last chance... Check armor */
-			if (tar->ArmorProtect(weaponClass)) {
-				if( debug ) {
-					Awrite( "---Protected by armour!" );
-				}
-				continue;
+	/* 6. If attack got through, apply effect, or kill */
+	if (!effect) {
+		/* 7. Last chance... Check armor */
+		if (ArmorProtect(tarArmor, tarShield, weaponClass, rb)) {
+			if( debug ) {
+				Awrite( "---Protected by armour!" );
 			}
+			return 0;
+		}
 
-			/* 8. Seeya! */
-			// Did we hit a mount?
-			if( tar->rider ) {
-				if (!tar->amuletofi) {
-					int hitsTaken = 1;
-					if( attackType == ATTACK_DISPEL ) {
-						hitsTaken = tar->hits;
-					}
-					tar->damage += hitsTaken;
-					tar->hits -= hitsTaken;
-					if( tar->hits <= 0 ) {
-						if( debug ) {
-							Awrite( "---Mount dead!" );
-						}
-						tar = tar->rider;
-						delete tar->mount;
-						tar->mount = 0;
-						tar->riding = -1;
-					}
+		/* 8. Seeya! */
+		// Did we hit a mount?
+		if( t >= count ) {
+			if (!amuletofi[t]) {
+				int hitsTaken = 1;
+				if( attackType == ATTACK_DISPEL ) {
+					hitsTaken = hits[t];
 				}
-			} else {
-				if( debug ) {
-					Awrite( AString("---Soldier takes 1 hit, taking it down to ") + tar->hits + ".");
+				damage[t] += hitsTaken;
+				hits[t] -= hitsTaken;
+				if( hits[t] <= 0 ) {
+					if( debug ) {
+						Awrite( "---Mount dead!" );
+					}
+					t -= count;
+					mount[t] = -1;
+					riding[t] = -1;
 				}
-				Kill(tarnum, attackType == ATTACK_DISPEL);
 			}
-			ret++;
 		} else {
-			if (tar->HasEffect(effect)) {
-				continue;
+			if( debug ) {
+				Awrite( AString("---Soldier takes 1 hit, taking it down to ") + hits[t] + ".");
 			}
-			tar->SetEffect(effect);
-			ret++;
+			Kill(tarnum, attackType == ATTACK_DISPEL);
+		}
+		return 1;
+	} else {
+		if (HasEffect(t, effect)) {
+			return 0;
+		}
+		SetEffect(t, effect);
+		return 1;
+	}
+}
+
+//
+// Resolve numAttacks plain attacks by one soldier as a batch, with the
+// same odds as numAttacks separate DoAnAttack calls.  Getting through a
+// shield and the 50% miss chance don't depend on the target, so they are
+// settled for the whole volley first and only the attacks that go in
+// pick a target.  The remaining draws come from a RandomBlock.
+//
+int Army::DoAttackBatch(int numAttacks, int attackType, int attackLevel,
+		int flags, int weaponClass, int mountBonus, int attackbehind) {
+	int canShield = 0;
+	int combat = 0;
+	switch(attackType) {
+		case ATTACK_RANGED:
+			canShield = 1;
+			// fall through
+		case ATTACK_COMBAT:
+		case ATTACK_RIDING:
+			combat = 1;
+			break;
+		case ATTACK_ENERGY:
+		case ATTACK_WEATHER:
+		case ATTACK_SPIRIT:
+			canShield = 1;
+			break;
+	}
+
+	Shield *hi = 0;
+	if (canShield) hi = shields.GetHighShield(attackType);
+
+	//
+	// A non-combat attack that gets through a shield destroys it, which
+	// changes the odds for the next one; leave those to DoAnAttack.
+	//
+	if (hi && !combat) {
+		int ret = 0;
+		for (int i = 0; i < numAttacks; i++) {
+			int numHit = DoAnAttack(0, 1, attackType, attackLevel, flags,
+					weaponClass, 0, mountBonus, attackbehind);
+			if (numHit != -1) ret += numHit;
+			if (!NumAlive()) break;
+		}
+		return ret;
+	}
+
+	int tohit = 1;
+	int tries = 1;
+	if (hi) {
+		int tomiss = 1;
+		if (attackLevel > hi->shieldskill) {
+			tohit = pow(2, attackLevel - hi->shieldskill);
+		} else if (hi->shieldskill > attackLevel) {
+			tomiss = pow(2, hi->shieldskill - attackLevel);
+		}
+		tries = tohit + tomiss;
+	}
+	int coin = attackType != NUM_ATTACK_TYPES &&
+		attackType != ATTACK_DISPEL && !(flags & WeaponType::ALWAYSREADY);
+
+	unsigned long shieldw[ATTACK_BATCH];
+	unsigned long coinw[ATTACK_BATCH];
+	int swings = 0;
+	int left = numAttacks;
+	while (left > 0) {
+		int n = left < ATTACK_BATCH ? left : ATTACK_BATCH;
+		left -= n;
+		if (hi) getrandomwords(shieldw, n);
+		else memset(shieldw, 0, n * sizeof(unsigned long));
+		if (coin) getrandomwords(coinw, n);
+		else memset(coinw, 0, n * sizeof(unsigned long));
+		for (int i = 0; i < n; i++) {
+			swings += ((int) (shieldw[i] % tries) < tohit) & !(coinw[i] & 1);
 		}
 	}
+
+	RandomBlock rb;
+	int ret = 0;
+	for (int i = 0; i < swings && NumAlive(); i++) {
+		int tarnum = GetTargetNum(0, attackbehind, &rb);
+		if (tarnum == -1) continue;
+		int level = attackLevel;
+		ret += ResolveAttack(tarnum, 0, attackType, level, flags,
+				weaponClass, 0, mountBonus, 0, &rb);
+	}
 	return ret;
 }
 
 void Army::Kill(int killed, int destroy) {
-	Soldier *temp = soldiers[killed];
+	int temp = soldiers[killed];
 
-	if (temp->amuletofi) return;
+	if (amuletofi[temp]) return;
 
 	int hitsTaken = 1;
 	if( destroy )
-		hitsTaken = temp->hits;
+		hitsTaken = hits[temp];
 
 	if (Globals->ARMY_ROUT == GameDefs::ARMY_ROUT_HITS_INDIVIDUAL)
 		hitsalive -= hitsTaken;
-	temp->damage += hitsTaken;
-	temp->hits -= hitsTaken;
-	if (temp->hits > 0) return;
-	temp->unit->losses++;
+	damage[temp] += hitsTaken;
+	hits[temp] -= hitsTaken;
+	if (hits[temp] > 0) return;
+	pool[temp].unit->losses++;
 	if (Globals->ARMY_ROUT == GameDefs::ARMY_ROUT_HITS_FIGURE) {
-		if (ItemDefs[temp->race].type & IT_MONSTER) {
-			hitsalive -= MonDefs[ItemDefs[temp->race].index].hits;
+		int race = pool[temp].race;
+		if (ItemDefs[race].type & IT_MONSTER) {
+			hitsalive -= MonDefs[ItemDefs[race].index].hits;
 		} else {
 			// Assume everything that is a soldier and isn't a monster is a
 			// man.
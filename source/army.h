@@ -38,9 +38,30 @@ class Army;
 
 #define SPECIAL_NONE 0
 
+//
+// With BATCHED_ATTACKS set, a soldier with at least ATTACK_BATCH_MIN
+// attacks in a round has them resolved together; random words are drawn
+// ATTACK_BATCH at a time.
+//
+#define ATTACK_BATCH 64
+#define ATTACK_BATCH_MIN 16
+
+class RandomBlock {
+	public:
+		RandomBlock();
+
+		// Same odds as getrandom(), from words drawn in advance.
+		int Get(int);
+
+	private:
+		unsigned long words[ATTACK_BATCH];
+		int left;
+};
+
 class Soldier {
 	public:
-		Soldier(Unit *unit, Object *object, int regType, int race, int ass=0);
+		Soldier(Army *army, int slot, Unit *unit, Object *object,
+				int regType, int race, int ass=0);
 
 		void SetupSpell();
 		void SetupCombatItems();
@@ -50,24 +71,27 @@ class Soldier {
 		//
 		void SetupHealing();
 
-		int HasEffect(int);
-		void SetEffect(int);
-		void ClearEffect(int);
-		void ClearOneTimeEffects(void);
-		int ArmorProtect(int weaponClass );
-
 		void RestoreItems();
 		void Alive(int);
 		void Dead();
 
+		//
+		// The display name is built on demand from race and unit, so
+		// setting up a soldier does not cost a string copy per man.
+		//
+		AString Name();
+
+		//
+		// The soldier's combat state (hits, weapon, armor, skills and
+		// effects) is kept by its army, in the arrays for this slot.
+		//
+		Army * army;
+		int slot;
+
 		/* Unit info */
-		AString name;
 		Unit * unit;
 		int race;
-		int riding;
 		int building;
-		Soldier * mount;
-		Soldier * rider;
 
 		/* Healing information */
 		int healing;
@@ -77,35 +101,18 @@ class Soldier {
 		int regen;
 
 		/* Attack info */
-		int weapon;
 		int attacktype;
-		int askill;
-		int attacks;
 		int special;
 		int slevel;
 		int specialfail;
 
-		/* Defense info */
-		int dskill[NUM_ATTACK_TYPES];
-		int armor;
-		int shield;
-		int hits;
-		int maxhits;
-		int damage;
-
 		int ring1;
 		int ring2;
 		int amulet;
 
 		BITFIELD battleItems;
-		int amuletofi;
-
-		/* Effects */
-		int effects;
 };
 
-typedef Soldier * SoldierPtr;
-
 class Army {
 	public:
 		Army(Unit *,AList *,int,int = 0);
@@ -131,12 +138,22 @@ class Army {
 		int NumFrontHits();
 		Soldier *GetAttacker( int, int & );
 		int GetEffectNum(int effect);
-		int GetTargetNum(int special, int attackbehind);
+		int GetTargetNum(int special, int attackbehind,
+				RandomBlock *rb = 0);
 		Soldier *GetTarget( int );
 		int RemoveEffects(int num, int effect);
+		int HasEffect(int slot, int effect);
+		void SetEffect(int slot, int effect);
+		void ClearEffect(int slot, int effect);
+		void ClearOneTimeEffects(int slot);
 		int DoAnAttack( int special, int numAttacks, int attackType,
 				int attackLevel, int flags, int weaponClass, int effect,
 				int mountBonus, int attackbehind);
+		int DoAttackBatch(int numAttacks, int attackType, int attackLevel,
+				int flags, int weaponClass, int mountBonus, int attackbehind);
+		int ResolveAttack(int tarnum, int special, int attackType,
+				int &attackLevel, int flags, int weaponClass, int effect,
+				int mountBonus, int coin, RandomBlock *rb);
 		void Kill(int, int destroy = 0);
 		void Reset();
 
@@ -145,7 +162,30 @@ class Army {
 		//
 		int CheckSpecialTarget(int,int);
 
-		SoldierPtr * soldiers;
+		//
+		// Each soldier has a slot, and its mount (if it rides one that
+		// fights) the slot count places after it; pool holds the Soldier
+		// records and the arrays below their combat state, one entry per
+		// slot (NUM_ATTACK_TYPES for dskill).  Item numbers and defence
+		// levels are shorts, to keep the arrays small.  soldiers[] holds
+		// the slots of the soldiers, which the front/behind partitions
+		// shuffle; a soldier's slot is also its place in the pool.
+		//
+		int * soldiers;
+		Soldier * pool;
+		int * hits;
+		int * maxhits;
+		int * damage;
+		short * weapon;
+		short * armor;
+		short * shield;
+		short * riding;
+		int * mount; // slot of the soldier's mount, or -1
+		char * amuletofi;
+		int * askill;
+		int * attacks;
+		int * effects;
+		short * dskill;
 		Unit * leader;
 		ShieldList shields;
 		int round;
@@ -26,73 +26,141 @@
 #include <string.h>
 #include <stdio.h>
 
+//
+// Short strings are kept in sso, inside the AString itself; longer ones
+// get a buffer from the heap.  += doubles the buffer when it runs out of
+// room, so building a string up a piece at a time copies it only a few
+// times.
+//
+void AString::Init(const char *s, int l) {
+	len = l;
+	if (l < ASTRING_SSO) {
+		str = sso;
+		size = ASTRING_SSO;
+	} else {
+		size = l + 1;
+		str = new char[size];
+	}
+	memcpy(str, s, l);
+	str[l] = '\0';
+}
+
+void AString::Free() {
+	if (str != sso && size) delete [] str;
+	str = sso;
+	size = ASTRING_SSO;
+}
+
+/* s may point into our own string */
+void AString::Assign(const char *s, int l) {
+	if (l >= size) {
+		char *temp = new char[l + 1];
+		memcpy(temp, s, l);
+		Free();
+		str = temp;
+		size = l + 1;
+	} else {
+		memmove(str, s, l);
+	}
+	len = l;
+	str[l] = '\0';
+}
+
 AString::AString() {
 	len = 0;
-	str = new char[1];
+	str = sso;
+	size = ASTRING_SSO;
 	str[0] = '\0';
 }
 
 AString::AString(char *s) {
-	len = strlen(s);
-	str = new char[len + 1];
-	strcpy(str,s);
+	Init(s, strlen(s));
 }
 
 AString::AString(const char *s) {
-	len = strlen(s);
-	str = new char[len + 1];
-	strcpy(str,s);
+	Init(s, strlen(s));
+}
+
+AString::AString(const char *s, int l) {
+	Init(s, l);
 }
 
 AString::AString(int l) {
 	char buf[16];
 	sprintf(buf,"%d",l);
-	len = strlen(buf);
-	str = new char[len+1];
-	strcpy(str,buf);
+	Init(buf, strlen(buf));
 }
 
 AString::AString(unsigned int l) {
 	char buf[16];
 	sprintf(buf,"%u",l);
-	len = strlen(buf);
-	str = new char[len+1];
-	strcpy(str,buf);
+	Init(buf, strlen(buf));
 }
 
 AString::AString(char c) {
-	len = 1;
-	str = new char[2];
-	str[0] = c;
-	str[1] = '\0';
+	Init(&c, 1);
 }
 
 AString::~AString() {
-	if (str) delete str;
+	if (str != sso && size) delete [] str;
 }
 
 AString::AString(const AString &s) {
-	len = s.len;
-	str = new char[len + 1];
-	strcpy(str,s.str);
+	Init(s.str, s.len);
 }
 
 AString & AString::operator=(const AString &s) {
-	len = s.len;
-	if (str) delete str;
-	str = new char[len + 1];
-	strcpy(str,s.str);
+	if (this != &s) Assign(s.str, s.len);
 	return *this;
 }
 
 AString & AString::operator=(const char *c) {
-	len = strlen(c);
-	if (str) delete str;
-	str = new char[len + 1];
-	strcpy(str,c);
+	Assign(c, strlen(c));
 	return *this;
 }
 
+#ifdef ASTRING_MOVE
+AString::AString(AString &&s) {
+	if (s.str == s.sso || !s.size) {
+		Init(s.str, s.len);
+		return;
+	}
+	len = s.len;
+	str = s.str;
+	size = s.size;
+	s.str = s.sso;
+	s.size = ASTRING_SSO;
+	s.len = 0;
+	s.sso[0] = '\0';
+}
+
+AString & AString::operator=(AString &&s) {
+	if (this == &s) return *this;
+	if (s.str == s.sso || !s.size) {
+		Assign(s.str, s.len);
+		return *this;
+	}
+	Free();
+	len = s.len;
+	str = s.str;
+	size = s.size;
+	s.str = s.sso;
+	s.size = ASTRING_SSO;
+	s.len = 0;
+	s.sso[0] = '\0';
+	return *this;
+}
+#endif
+
+void AString::Reserve(int n) {
+	if (n < size) return;
+	char *temp = new char[n + 1];
+	memcpy(temp, str, len + 1);
+	Free();
+	str = temp;
+	size = n + 1;
+}
+
 int AString::operator==(char *s) {
 	return isEqual(s);
 }
@@ -124,32 +192,39 @@ int AString::isEqual(const char *temp2) {
 	return 0;
 }
 
+#ifdef ASTRING_MOVE
+AString AString::operator+(const AString &s) & {
+#else
 AString AString::operator+(const AString &s) {
-	char *temp = new char[len+s.len+1];
-	int i;
-	for (i=0; i<len; i++) {
-		temp[i] = str[i];
-	}
-	for (int j=0; j<s.len+1; j++) {
-		temp[i++] = s.str[j];
-	}
-	AString temp2 = AString(temp);
-	delete temp;
-	return temp2;
+#endif
+	AString temp;
+	temp.Reserve(len + s.len);
+	memcpy(temp.str, str, len);
+	memcpy(temp.str + len, s.str, s.len);
+	temp.len = len + s.len;
+	temp.str[temp.len] = '\0';
+	return temp;
+}
+
+#ifdef ASTRING_MOVE
+/* The left side is a temporary, so the result can be built in it */
+AString AString::operator+(const AString &s) && {
+	*this += s;
+	return std::move(*this);
 }
+#endif
 
 AString &AString::operator+=(const AString &s) {
-	char *temp = new char[len+s.len+1];
-	int i;
-	for (i=0; i<len; i++) {
-		temp[i] = str[i];
-	}
-	for (int j=0; j<s.len+1; j++) {
-		temp[i++] = s.str[j];
+	int slen = s.len;
+	if (len + slen >= size) {
+		int room = 2 * (size - 1);
+		if (room < len + slen) room = len + slen;
+		Reserve(room);
 	}
-	delete str;
-	str = temp;
-	len = len + s.len;
+	/* s may be this string; its characters are still at the front */
+	memcpy(str + len, s.str, slen);
+	len += slen;
+	str[len] = '\0';
 	return *this;
 }
 
@@ -181,10 +256,7 @@ AString *AString::gettoken() {
 			place++;
 		} else {
 			/* Unmatched "" return 0 */
-			delete str;
-			str = new char[1];
-			len = 0;
-			str[0] = '\0';
+			Assign("", 0);
 			return 0;
 		}
 	} else {
@@ -195,23 +267,10 @@ AString *AString::gettoken() {
 	}
 	buf[place2] = '\0';
 	if (place == len || str[place] == ';') {
-		delete str;
-		str = new char[1];
-		len = 0;
-		str[0] = '\0';
+		Assign("", 0);
 		return new AString(buf);
 	}
-	char * buf2 = new char[len-place2+1];
-	int newlen = 0;
-	place2 = 0;
-	while (place < len) {
-		buf2[place2++] = str[place++];
-		newlen++;
-	}
-	buf2[place2] = '\0';
-	len = newlen;
-	delete str;
-	str = buf2;
+	Assign(str + place, len - place);
 	return new AString(buf);
 }
 
@@ -316,9 +375,218 @@ ostream & operator <<(ostream & os,const AString & s) {
 istream & operator >>(istream & is,AString & s) {
 	char * buf = new char[256];
 	is >> buf;
-	s.len = strlen(buf);
-	s.str = new char[s.len + 1];
-	strcpy(s.str,buf);
+	s.Assign(buf, strlen(buf));
 	delete buf;
 	return is;
 }
+
+static inline char FoldChar(char c) {
+	if ((c >= 'A') && (c <= 'Z')) return c - 'A' + 'a';
+	if (c == '_') return ' ';
+	return c;
+}
+
+static unsigned int HashName(const char *s) {
+	unsigned int h = 2166136261u;
+	while (*s) {
+		h ^= (unsigned char) FoldChar(*s++);
+		h *= 16777619u;
+	}
+	return h;
+}
+
+NameIndex::NameIndex() {
+	keys = 0;
+	values = 0;
+	next = 0;
+	heads = 0;
+	num = 0;
+	size = 0;
+	buckets = 0;
+}
+
+NameIndex::~NameIndex() {
+	Clear();
+	delete [] keys;
+	delete [] values;
+	delete [] next;
+	delete [] heads;
+}
+
+void NameIndex::Rehash(int nbuckets) {
+	delete [] heads;
+	buckets = nbuckets;
+	heads = new int[buckets];
+	for (int i = 0; i < buckets; i++) heads[i] = -1;
+	for (int i = 0; i < num; i++) {
+		int b = HashName(keys[i]) & (buckets - 1);
+		next[i] = heads[b];
+		heads[b] = i;
+	}
+}
+
+void NameIndex::Add(const char *name, int value) {
+	if (!name) return;
+	if (num == size) {
+		int newsize = size ? size * 2 : 64;
+		char **newkeys = new char *[newsize];
+		int *newvalues = new int[newsize];
+		int *newnext = new int[newsize];
+		for (int i = 0; i < num; i++) {
+			newkeys[i] = keys[i];
+			newvalues[i] = values[i];
+			newnext[i] = next[i];
+		}
+		delete [] keys;
+		delete [] values;
+		delete [] next;
+		keys = newkeys;
+		values = newvalues;
+		next = newnext;
+		size = newsize;
+	}
+
+	int len = strlen(name);
+	char *key = new char[len + 1];
+	for (int i = 0; i <= len; i++) key[i] = FoldChar(name[i]);
+	keys[num] = key;
+	values[num] = value;
+	num++;
+
+	if (num * 2 > buckets) {
+		Rehash(buckets ? buckets * 2 : 128);
+	} else {
+		int b = HashName(key) & (buckets - 1);
+		next[num - 1] = heads[b];
+		heads[b] = num - 1;
+	}
+}
+
+int NameIndex::Find(const char *name, int after) {
+	if (!num) return -1;
+	int found = -1;
+	for (int i = heads[HashName(name) & (buckets - 1)]; i != -1; i = next[i]) {
+		if (values[i] <= after) continue;
+		if (found != -1 && values[i] >= found) continue;
+		const char *a = keys[i];
+		const char *b = name;
+		while (*a && *a == FoldChar(*b)) {
+			a++;
+			b++;
+		}
+		if (!*a && !*b) found = values[i];
+	}
+	return found;
+}
+
+int NameIndex::Num() {
+	return num;
+}
+
+void NameIndex::Clear() {
+	for (int i = 0; i < num; i++) delete [] keys[i];
+	num = 0;
+	for (int i = 0; i < buckets; i++) heads[i] = -1;
+}
+
+ATokenizer::ATokenizer() {
+	buf = 0;
+	len = 0;
+	size = 0;
+	pos = 0;
+	tokens = 0;
+	used = 0;
+	ntokens = 0;
+}
+
+ATokenizer::ATokenizer(AString *line) {
+	buf = 0;
+	len = 0;
+	size = 0;
+	pos = 0;
+	tokens = 0;
+	used = 0;
+	ntokens = 0;
+	Set(line);
+}
+
+ATokenizer::~ATokenizer() {
+	for (int i = 0; i < ntokens; i++) delete tokens[i];
+	delete [] tokens;
+	delete [] buf;
+}
+
+void ATokenizer::Set(AString *line) {
+	len = line->len;
+	if (len >= size) {
+		delete [] buf;
+		size = len + 64;
+		buf = new char[size];
+	}
+	memcpy(buf, line->str, len + 1);
+	pos = 0;
+	used = 0;
+}
+
+int ATokenizer::getat() {
+	int place = pos;
+	while (place < len && (buf[place] == ' ' || buf[place] == '\t'))
+		place++;
+	if (place >= len) return 0;
+	if (buf[place] == '@') {
+		buf[place] = ' ';
+		return 1;
+	}
+	return 0;
+}
+
+AString *ATokenizer::gettoken() {
+	while (pos < len && (buf[pos] == ' ' || buf[pos] == '\t'))
+		pos++;
+	if (pos >= len) return 0;
+	if (buf[pos] == ';') return 0;
+
+	int start, end;
+	if (buf[pos] == '"') {
+		start = ++pos;
+		while (pos < len && buf[pos] != '"') pos++;
+		if (pos == len) {
+			/* Unmatched "" return 0 */
+			return 0;
+		}
+		end = pos++;
+	} else {
+		start = pos;
+		while (pos < len &&
+				(buf[pos] != ' ' && buf[pos] != '\t' && buf[pos] != ';'))
+			pos++;
+		end = pos;
+	}
+	if (pos == len || buf[pos] == ';') {
+		/* The rest of the line is a comment */
+		pos = len;
+	} else if (end == pos) {
+		/* Step over the space the token ends in; it becomes the NUL */
+		pos++;
+	}
+	buf[end] = '\0';
+
+	if (used == ntokens) {
+		int newmax = ntokens ? ntokens * 2 : 8;
+		AString **temp = new AString *[newmax];
+		int i;
+		for (i = 0; i < ntokens; i++) temp[i] = tokens[i];
+		for (; i < newmax; i++) {
+			/* A size of 0 keeps the token from freeing the buffer */
+			temp[i] = new AString;
+			temp[i]->size = 0;
+		}
+		delete [] tokens;
+		tokens = temp;
+		ntokens = newmax;
+	}
+	AString *token = tokens[used++];
+	token->str = buf + start;
+	token->len = end - start;
+	return token;
+}
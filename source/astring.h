@@ -26,36 +26,59 @@
 #define ASTRING_CLASS
 
 #include <iostream>
+#include <utility>
 using namespace std;
 
 #include "alist.h"
 
+// Moving strings needs a compiler with rvalue references
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define ASTRING_MOVE
+#endif
+
+/* Strings shorter than this are kept inside the AString, off the heap */
+#define ASTRING_SSO 16
+
 class AString : public AListElem {
     friend ostream & operator <<(ostream &os, const AString &);
     friend istream & operator >>(istream &is, AString &);
+    friend class ATokenizer;
 public:
 
     AString();
     AString(char *);
     AString(const char *);
+    AString(const char *, int);
     AString(int);
 	AString(unsigned int);
     AString(char);
     AString(const AString &);
+#ifdef ASTRING_MOVE
+    AString(AString &&);
+#endif
     ~AString();
 
     int operator==(const AString &);
     int operator==(char *);
     int operator==(const char *);
     int CheckPrefix(const AString &);
+#ifdef ASTRING_MOVE
+    AString operator+(const AString &) &;
+    AString operator+(const AString &) &&;
+#else
     AString operator+(const AString &);
+#endif
     AString & operator+=(const AString &);
 
     AString & operator=(const AString &);
+#ifdef ASTRING_MOVE
+    AString & operator=(AString &&);
+#endif
     AString & operator=(const char *);
 
     char *Str();
     int Len();
+    void Reserve(int); /* Make room for this many characters */
 
     AString *gettoken();
     int getat();
@@ -68,11 +91,74 @@ public:
 private:
 
     int len;
-	int size;
+	int size; /* Room in str, counting the NUL; 0 if str is not ours */
     char * str;
+	char sso[ASTRING_SSO];
     int isEqual(const char *);
+	void Init(const char *, int);
+	void Assign(const char *, int);
+	void Free();
 };
 
 char islegal(char c);
 
+//
+// ATokenizer splits an order line into tokens without copying them.
+// Set() copies the line into a buffer that is kept from line to line, and
+// gettoken() cuts the next token out of that buffer in place.  The tokens
+// are AStrings that borrow the buffer: they stay good until the next
+// Set(), and must not be deleted or changed.  Copy one to keep it.
+// Tokens split the same way as with AString::gettoken(): on spaces and
+// tabs, with "quoted" tokens holding spaces and ';' starting a comment.
+//
+class ATokenizer {
+	public:
+		ATokenizer();
+		ATokenizer(AString *);
+		~ATokenizer();
+
+		void Set(AString *);
+		int getat();
+		AString *gettoken();
+
+	private:
+		char *buf;
+		int len;
+		int size;
+		int pos;
+
+		AString **tokens;
+		int used;
+		int ntokens;
+};
+
+//
+// A hash table from names to table positions, for looking tokens up in
+// the game data tables.  Names match the way AString's == compares them:
+// case does not matter and '_' matches ' '.  Several positions may share
+// a name; Find gives the lowest one above 'after', so a lookup returns
+// what a scan of the table for the first match would.
+//
+class NameIndex {
+	public:
+		NameIndex();
+		~NameIndex();
+
+		void Add(const char *, int);
+		int Find(const char *, int after = -1); /* -1 if there is none */
+		int Num();
+		void Clear();
+
+	private:
+		void Rehash(int);
+
+		char **keys;
+		int *values;
+		int *next;
+		int *heads;
+		int num;
+		int size;
+		int buckets;
+};
+
 #endif
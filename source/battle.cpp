@@ -87,7 +87,7 @@ void Battle::FreeRound(Army * att,Army * def, int ass, bool attIsAttacker ) {
 		int behind;
 		Soldier * a = att->GetAttacker(num, behind);
 		if(debug) {
-			Awrite( a->name + " (" + num + ") attacks!" );
+			Awrite( a->Name() + " (" + num + ") attacks!" );
 		}
 		DoAttack(att->round, a, att, def, behind, ass, overwhelmed);
 	}
@@ -155,14 +155,25 @@ void Battle::DoAttack(int round, Soldier *a, Army *attackers, Army *def,
 {
 	int debug = 0;
 
+	//
+	// Read the attacker's state from its army's arrays up front, without
+	// waiting on its Soldier record; nothing in this attack changes it.
+	//
+	int s = a - attackers->pool;
+	int riding = attackers->riding[s];
+	int attacks = attackers->attacks[s];
+	int weapon = attackers->weapon[s];
+	int askill = attackers->askill[s];
+	int mount = attackers->mount[s];
+
 //	if( a->unit->num == 1134 ) debug=1;
 if( debug ) Awrite("1");
 	DoSpecialAttack(round, a, attackers, def, behind, canattackback);
 	if (!def->NumAlive()) return;
 if( debug ) Awrite("2");
 
-	if (!behind && (a->riding != -1)) {
-		MountType *pMt = &MountDefs[ItemDefs[a->riding].index];
+	if (!behind && (riding != -1)) {
+		MountType *pMt = &MountDefs[ItemDefs[riding].index];
 		if (pMt->mountSpecial != -1) {
 			int i, num, tot = -1;
 			SpecialType *spd = &SpecialDefs[pMt->mountSpecial];
@@ -186,7 +197,7 @@ if( debug ) Awrite("2");
 			}
 			if (tot != -1) {
 				if( !Globals->AGGREGATE_BATTLE_REPORTS ) {
-					AddLine(a->name + " " + spd->spelldesc + ", " +
+					AddLine(a->Name() + " " + spd->spelldesc + ", " +
 							spd->spelldesc2 + tot + spd->spelltarget + ".");
 				} 
 			}
@@ -194,7 +205,7 @@ if( debug ) Awrite("2");
 	}
 	if (!def->NumAlive()) return;
 
-	int numAttacks = a->attacks;
+	int numAttacks = attacks;
 	int totHit = 0;
 	int fullreport = 0;
 if( debug ) Awrite( AString("Num attacks : ") + numAttacks );
@@ -206,8 +217,8 @@ if( debug ) Awrite( AString("Num attacks : ") + numAttacks );
 	}
 if( debug ) Awrite( AString("Full report : ") + fullreport );
 
-	if (a->attacks < 0) {
-		if (round % (-1 * a->attacks) == 1)
+	if (attacks < 0) {
+		if (round % (-1 * attacks) == 1)
 			numAttacks = 1;
 		else
 			numAttacks = 0;
@@ -217,7 +228,8 @@ if( debug ) Awrite( AString("Full report : ") + fullreport );
 	}
 
 	WeaponType *pWep = 0;
-	if (a->weapon != -1) pWep = &WeaponDefs[ItemDefs[a->weapon ].index];
+	if (weapon != -1)
+		pWep = &WeaponDefs[ItemDefs[weapon].index];
 	int flags = WeaponType::SHORT;
 	int attackType = ATTACK_COMBAT;
 	int mountBonus = 0;
@@ -234,24 +246,30 @@ if( debug ) Awrite( AString("Full report : ") + fullreport );
 	}
 if( debug ) Awrite( AString("Num attacks : ") + numAttacks );
 
-	for (int i = 0; i < numAttacks; i++) {
-		if( debug ) {
-			AString * temp = new AString;
-			if( debug )
-				*temp = AString("**") + a->name + " attacked with a combat skill of " + a->askill + ".";
-			attackers->roundLeaderReports.Add( temp );
-		}
-		int numHit = def->DoAnAttack(0, 1, attackType, a->askill, flags, attackClass,
-				0, mountBonus, canattackback);
-		if( numHit != -1 ) totHit += numHit;
+	if (Globals->BATCHED_ATTACKS && numAttacks >= ATTACK_BATCH_MIN &&
+			!debug) {
+		totHit = def->DoAttackBatch(numAttacks, attackType, askill, flags,
+				attackClass, mountBonus, canattackback);
+	} else {
+		for (int i = 0; i < numAttacks; i++) {
+			if( debug ) {
+				AString * temp = new AString;
+				if( debug )
+					*temp = AString("**") + a->Name() + " attacked with a combat skill of " + askill + ".";
+				attackers->roundLeaderReports.Add( temp );
+			}
+			int numHit = def->DoAnAttack(0, 1, attackType, askill, flags, attackClass,
+					0, mountBonus, canattackback);
+			if( numHit != -1 ) totHit += numHit;
 
-		if (!def->NumAlive()) break;
+			if (!def->NumAlive()) break;
+		}
 	}
 
 	if( Globals->AGGREGATE_BATTLE_REPORTS && numAttacks > 0 ) {
 		if( fullreport ) {
 			if( totHit < 0 ) totHit = 0;
-			AString temp = a->name + " does " + numAttacks + " " + WeapClass( attackClass ) +
+			AString temp = a->Name() + " does " + numAttacks + " " + WeapClass( attackClass ) +
 				" attack" + ( numAttacks == 1 ? "" : "s" ) + " killing " + totHit + ".";
 			attackers->roundLeaderReports.Add( new AString( temp ) );
 		} else {
@@ -261,11 +279,12 @@ if( debug ) Awrite( AString("Num attacks : ") + numAttacks );
 	}
 if( debug ) Awrite( "-Done Attack" );
 
-	a->ClearOneTimeEffects();
+	attackers->ClearOneTimeEffects(s);
 
 	// Mount gets to attack too. They will always attack as if in the frontline
-	if( a->mount )
-		DoAttack(round, a->mount, attackers, def, 0/*behind*/, ass, canattackback);
+	if( mount != -1 )
+		DoAttack(round, &attackers->pool[mount], attackers, def,
+				0/*behind*/, ass, canattackback);
 	
 }
 
@@ -0,0 +1,173 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+
+//
+// Battle benchmark: fights the same battle between two large armies
+// several times from a fixed random seed and reports the time per
+// battle.  The attackers are armed, armoured and mounted men, with
+// archers behind them and war mounts if the game has any; the defenders
+// are men with swords and a horde of skeletons.  The battle is fought
+// round by round as in Battle::Run, without the spoils, so every run
+// ends the same way, and the result line can be compared between builds.
+//
+// make GAME=<game> battlebench; <game>/battlebench [men] [runs] [seed]
+//
+#include "game.h"
+#include "battle.h"
+#include "profile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_UNIT_SIZE 100
+
+static int WarMount() {
+	for (int i = 0; i < NITEMS; i++) {
+		if (ItemDefs[i].flags & ItemType::DISABLED) continue;
+		if (!(ItemDefs[i].type & IT_MOUNT)) continue;
+		if (MountDefs[ItemDefs[i].index].monster != -1) return i;
+	}
+	return -1;
+}
+
+static Unit *AddUnit(AList *units, AList *locs, Faction *f, Object *o,
+		int num, int men) {
+	Unit *u = new Unit(num, f);
+	u->SetMen(I_MAN, men);
+	u->SetSkill(S_COMBAT, 3);
+	u->SetSkill(S_RIDING, 3);
+	u->SetSkill(WeaponDefs[ItemDefs[I_LONGBOW].index].baseSkill, 3);
+	u->object = o;
+	UnitPtr *up = new UnitPtr;
+	up->ptr = u;
+	units->Add(up);
+	Location *l = new Location;
+	l->unit = u;
+	l->obj = o;
+	l->region = 0;
+	locs->Add(l);
+	return u;
+}
+
+//
+// Build both sides afresh, since setting up an army takes the soldiers'
+// equipment out of their units.
+//
+static void MakeSides(AList *units, AList *atts, AList *defs, Faction *fa,
+		Faction *fd, Object *o, int men, int mount) {
+	int num = 1;
+	int left;
+	for (left = men; left > 0; left -= BENCH_UNIT_SIZE) {
+		int n = left < BENCH_UNIT_SIZE ? left : BENCH_UNIT_SIZE;
+		Unit *u = AddUnit(units, atts, fa, o, num, n);
+		if (num % 4 == 0) {
+			u->items.SetNum(I_LONGBOW, n);
+			u->SetFlag(FLAG_BEHIND, 1);
+		} else {
+			u->items.SetNum(I_SWORD, n);
+			u->items.SetNum(I_LEATHERARMOR, n);
+			if (num % 4 == 1 && mount != -1)
+				u->items.SetNum(mount, n);
+			else
+				u->items.SetNum(I_HORSE, n);
+		}
+		num++;
+	}
+	for (left = men; left > 0; left -= BENCH_UNIT_SIZE) {
+		Unit *u = AddUnit(units, defs, fd, o, num, BENCH_UNIT_SIZE);
+		u->items.SetNum(I_SWORD, BENCH_UNIT_SIZE);
+		u->items.SetNum(I_LEATHERARMOR, BENCH_UNIT_SIZE);
+		u->items.SetNum(I_SKELETON, BENCH_UNIT_SIZE);
+		num++;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	int men = argc > 1 ? atoi(argv[1]) : 4000;
+	int runs = argc > 2 ? atoi(argv[2]) : 5;
+	int seed = argc > 3 ? atoi(argv[3]) : 1783;
+	if (men < 1 || runs < 1) {
+		printf("usage: battlebench [men] [runs] [seed]\n");
+		return 1;
+	}
+
+	int mount = WarMount();
+	Faction fa(1);
+	Faction fd(2);
+	Object o(0);
+
+	double setup = 0;
+	double fight = 0;
+	double fastest = 0;
+	for (int run = 0; run < runs; run++) {
+		AList units;
+		AList atts;
+		AList defs;
+		MakeSides(&units, &atts, &defs, &fa, &fd, &o, men, mount);
+		Unit *att = ((Location *) atts.First())->unit;
+		Unit *def = ((Location *) defs.First())->unit;
+
+		seedrandom(seed);
+		double start = Aclock();
+		Battle *b = new Battle;
+		Army *a = new Army(att, &atts, R_PLAIN);
+		Army *d = new Army(def, &defs, R_PLAIN);
+		double mid = Aclock();
+		int round = 1;
+		while (!a->Broken() && !d->Broken() && round < 101)
+			b->NormalRound(round++, a, d);
+		double end = Aclock();
+		int aalive = a->NumAlive();
+		int dalive = d->NumAlive();
+		int lines = b->text.Num();
+		delete a;
+		delete d;
+		delete b;
+
+		setup += mid - start;
+		fight += end - mid;
+		if (!run || end - mid < fastest) fastest = end - mid;
+		if (!run) {
+			printf("%d attackers against %d men and %d skeletons%s\n",
+					men, defs.Num() * BENCH_UNIT_SIZE,
+					defs.Num() * BENCH_UNIT_SIZE,
+					mount == -1 ? "" : ", with war mounts");
+			printf("Result: %d rounds, %d and %d left alive, %d lines, "
+					"next random %d\n", round - 1, aalive, dalive, lines,
+					getrandom(1000000));
+		}
+
+		forlist(&units) {
+			delete ((UnitPtr *) elem)->ptr;
+		}
+		units.DeleteAll();
+		atts.DeleteAll();
+		defs.DeleteAll();
+	}
+	printf("Setting up the armies: %.2f ms average\n", setup / runs * 1e3);
+	printf("Fighting the rounds: %.2f ms average, %.2f ms fastest of %d\n",
+			fight / runs * 1e3, fastest * 1e3, runs);
+	return 0;
+}
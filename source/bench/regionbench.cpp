@@ -0,0 +1,130 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+
+//
+// Micro-benchmark for ARegionList::GetRegion(int) and FindGate: times
+// the region and gate indexes against the scan of the region list that
+// they replaced, on a list of 20000 regions with 100 gates, and checks
+// that both give the same answers.
+//
+// make GAME=<game> regionbench; <game>/regionbench [regions] [gates]
+//
+#include "game.h"
+#include "profile.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static ARegion *ScanGetRegion(ARegionList *list, int n) {
+	forlist(list) {
+		ARegion *r = (ARegion *) elem;
+		if (r->num == n) return r;
+	}
+	return 0;
+}
+
+static ARegion *ScanFindGate(ARegionList *list, int x) {
+	if (x == 0) return 0;
+	forlist(list) {
+		ARegion *r = (ARegion *) elem;
+		if (r->gate == x) return r;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	int regions = argc > 1 ? atoi(argv[1]) : 20000;
+	int gates = argc > 2 ? atoi(argv[2]) : 100;
+	if (regions < 1 || gates < 1 || gates > regions) {
+		printf("usage: regionbench [regions] [gates]\n");
+		return 1;
+	}
+
+	ARegionList list;
+	int every = regions / gates;
+	int i;
+	for (i = 0; i < regions; i++) {
+		ARegion *r = new ARegion;
+		r->num = i;
+		if (i % every == every / 2 && i / every < gates)
+			r->gate = i / every + 1;
+		list.Add(r);
+	}
+
+	// The same lookups on every run
+	int queries = 20000;
+	int repeat = 100;
+	int *nums = new int[queries];
+	int *gatenums = new int[queries];
+	srand(1);
+	for (i = 0; i < queries; i++) {
+		nums[i] = rand() % regions;
+		gatenums[i] = rand() % gates + 1;
+	}
+
+	for (i = 0; i < queries; i++) {
+		if (ScanGetRegion(&list, nums[i]) != list.GetRegion(nums[i]) ||
+				ScanFindGate(&list, gatenums[i]) !=
+				list.FindGate(gatenums[i])) {
+			printf("Lookups differ for region %d or gate %d\n", nums[i],
+					gatenums[i]);
+			return 1;
+		}
+	}
+
+	long found = 0;
+	double start = Aclock();
+	for (i = 0; i < queries; i++)
+		found += ScanGetRegion(&list, nums[i]) != 0;
+	double scanregion = (Aclock() - start) / queries;
+
+	start = Aclock();
+	for (int k = 0; k < repeat; k++)
+		for (i = 0; i < queries; i++)
+			found += list.GetRegion(nums[i]) != 0;
+	double getregion = (Aclock() - start) / queries / repeat;
+
+	start = Aclock();
+	for (i = 0; i < queries; i++)
+		found += ScanFindGate(&list, gatenums[i]) != 0;
+	double scangate = (Aclock() - start) / queries;
+
+	start = Aclock();
+	for (int k = 0; k < repeat; k++)
+		for (i = 0; i < queries; i++)
+			found += list.FindGate(gatenums[i]) != 0;
+	double findgate = (Aclock() - start) / queries / repeat;
+
+	printf("%d regions, %d gates, %d lookups (%ld found)\n", regions, gates,
+			queries, found);
+	printf("GetRegion: scan %.3f us, index %.4f us per call\n",
+			scanregion * 1e6, getregion * 1e6);
+	printf("FindGate:  scan %.3f us, index %.4f us per call\n",
+			scangate * 1e6, findgate * 1e6);
+
+	delete [] nums;
+	delete [] gatenums;
+	return 0;
+}
@@ -225,6 +225,8 @@ static GameDefs g = {
 	1,  // AGGREGATE_BATTLE_REPORTS
 	0,	// MULTIPLE_MAGES_PER_UNIT
 	1,	// DISABLE_RESTART
+	0,	// BATCHED_ATTACKS
+	0,	// REGION_RANDOM_STREAMS
 	0,  // CODE_TEST
 
 };
@@ -863,7 +863,7 @@ void EditRegionPage::OnButton( wxCommandEvent & event )
 						break;
 					}
 					AddToControl( editType, TerrainDefs[type].name );
-					r->type = type;
+					r->SetType( type );
 					// recreate region data?
 					if( GuiConfig.recreateData ) {
 						// delete markets
@@ -2128,10 +2128,18 @@ void EditUnitPage::OnTextUpdate( wxCommandEvent & event )
 			UpdateControl( editDescribe, u->describe );
 			break;
 		case Edit_Unit_Type:
-				UpdateControl( editType, u->type );
+			{
+				int type = u->type;
+				UpdateControl( editType, type );
+				u->SetType( type );
+			}
 			break;
 		case Edit_Unit_Guard:
-				UpdateControl( editGuard, u->guard );
+			{
+				int guard = u->guard;
+				UpdateControl( editGuard, guard );
+				u->SetGuard( guard );
+			}
 			break;
 		case Edit_Unit_Reveal:
 				UpdateControl( editReveal, u->reveal );
@@ -254,8 +254,8 @@ Unit * GuiApp::AddUnit(Faction * pFaction)
 		nu->free = u->free;
 		nu->readyItem = u->readyItem;
 		nu->SetName( u->name->getlegal2() );
-		nu->type = u->type;
-		nu->guard = u->guard;
+		nu->SetType( u->type );
+		nu->SetGuard( u->guard );
 		forlist( &u->items ) {
 			Item * i = ( Item * ) elem;
 			nu->items.SetNum( i->type, i->num );
@@ -336,6 +336,7 @@ int GuiApp::LoadGame ( const char * FName )
 		
 		m_game = new Game;
 		m_game->ModifyTablesPerRuleset();
+		m_game->IndexNames();
 		if( m_game->OpenGame( FName ) ) {
 			PostLoadGame();
 			frame->CreatePanes();
@@ -208,6 +208,7 @@ void Faction::Readin(Ainfile *f, ATL_VER v) {
 			attitudes.Add(a);
 		}
 	}
+	IndexAttitudes();
 }
 
 void Faction::View() {
@@ -588,7 +589,69 @@ void Faction::CheckExist(ARegionList * regs) {
 	}
 }
 
+enum {
+	LOG_EVENT,
+	LOG_ERROR,
+	LOG_ITEM
+};
+
+class FactionLogEntry : public AListElem {
+public:
+	Faction *faction;
+	int type;
+	AString text;
+	int item;
+	int force;
+	int full;
+};
+
+static THREAD_LOCAL FactionLog *curfactionlog = 0;
+
+FactionLog *UseFactionLog(FactionLog *l) {
+	FactionLog *old = curfactionlog;
+	curfactionlog = l;
+	return old;
+}
+
+FactionLog *CurrentFactionLog() {
+	return curfactionlog;
+}
+
+void FactionLog::Add(Faction *f, int type, const AString &text, int item,
+		int force, int full) {
+	FactionLogEntry *e = new FactionLogEntry;
+	e->faction = f;
+	e->type = type;
+	e->text = text;
+	e->item = item;
+	e->force = force;
+	e->full = full;
+	entries.Add(e);
+}
+
+void FactionLog::Replay() {
+	forlist(&entries) {
+		FactionLogEntry *e = (FactionLogEntry *) elem;
+		switch (e->type) {
+			case LOG_EVENT:
+				e->faction->Event(e->text);
+				break;
+			case LOG_ERROR:
+				e->faction->Error(e->text);
+				break;
+			case LOG_ITEM:
+				e->faction->DiscoverItem(e->item, e->force, e->full);
+				break;
+		}
+	}
+	entries.DeleteAll();
+}
+
 void Faction::Error(const AString &s) {
+	if (curfactionlog) {
+		curfactionlog->Add(this, LOG_ERROR, s);
+		return;
+	}
 	if (IsNPC()) return;
 	if (errors.Num() > 1000) {
 		if (errors.Num() == 1001) {
@@ -602,17 +665,34 @@ void Faction::Error(const AString &s) {
 }
 
 void Faction::Event(const AString &s) {
+	if (curfactionlog) {
+		curfactionlog->Add(this, LOG_EVENT, s);
+		return;
+	}
 	if (IsNPC()) return;
 	AString *temp = new AString(s);
 	events.Add(temp);
 }
 
-void Faction::RemoveAttitude(int f) {
+void Faction::IndexAttitudes() {
+	attitudeindex.Clear();
 	forlist((&attitudes)) {
 		Attitude *a = (Attitude *) elem;
+		attitudeindex.Insert(a->factionnum, a);
+	}
+}
+
+void Faction::RemoveAttitude(int f) {
+	Attitude *a = (Attitude *) attitudeindex.Find(f);
+	if (!a) return;
+	attitudes.Remove(a);
+	attitudeindex.Erase(f);
+	delete a;
+	// Old game files may have more than one entry for a faction
+	forlist((&attitudes)) {
+		a = (Attitude *) elem;
 		if (a->factionnum == f) {
-			attitudes.Remove(a);
-			delete a;
+			attitudeindex.Insert(f, a);
 			return;
 		}
 	}
@@ -620,33 +700,27 @@ void Faction::RemoveAttitude(int f) {
 
 int Faction::GetAttitude(int n) {
 	if (n == num) return A_ALLY;
-	forlist((&attitudes)) {
-		Attitude *a = (Attitude *) elem;
-		if (a->factionnum == n)
-			return a->attitude;
-	}
+	Attitude *a = (Attitude *) attitudeindex.Find(n);
+	if (a) return a->attitude;
 	return defaultattitude;
 }
 
 void Faction::SetAttitude(int num,int att) {
-	forlist((&attitudes)) {
-		Attitude *a = (Attitude *) elem;
-		if (a->factionnum == num) {
-			if (att == -1) {
-				attitudes.Remove(a);
-				delete a;
-				return;
-			} else {
-				a->attitude = att;
-				return;
-			}
+	Attitude *a = (Attitude *) attitudeindex.Find(num);
+	if (a) {
+		if (att == -1) {
+			RemoveAttitude(num);
+		} else {
+			a->attitude = att;
 		}
+		return;
 	}
 	if (att != -1) {
-		Attitude *a = new Attitude;
+		a = new Attitude;
 		a->factionnum = num;
 		a->attitude = att;
 		attitudes.Add(a);
+		attitudeindex.Insert(num, a);
 	}
 }
 
@@ -677,7 +751,20 @@ int Faction::CanSee(ARegion * r,Unit * u, int practise, int activeUse) {
 //		hideLevel = u->GetSkill(S_SCOUTING) + 1;
 
 	int hideLevel = u->GetStealthLevel( activeUse );
-	
+
+	if (!practise) {
+		// Without practise the region's vision cache has all we need
+		if (u->object && u->object->region == r &&
+				u->object->type != O_DUMMY) retval = 1;
+		FactionVision *v = r->GetVision(this);
+		if (v) {
+			if (v->observation > hideLevel) return 2;
+			if (v->observation == hideLevel && retval < 1) retval = 1;
+			if (retval == 1 && v->mindreading > 2) return 2;
+		}
+		return retval;
+	}
+
 	forlist((&r->objects)) {
 		Object * obj = (Object *) elem;
 		int dummy = 0;
@@ -750,6 +837,10 @@ Faction *GetFaction2(AList *facs, int n) {
 }
 
 void Faction::DiscoverItem(int item, int force, int full) {
+	if (curfactionlog) {
+		curfactionlog->Add(this, LOG_ITEM, AString(), item, force, full);
+		return;
+	}
 	int seen = items.GetNum(item);
 	if (!seen) {
 		if (full) {
@@ -108,6 +108,25 @@ public:
 	Faction * ptr;
 };
 
+//
+// While region tasks run on worker threads, the changes they make to
+// factions (events, errors and discovered items) are queued on the
+// thread's FactionLog instead, and applied on the main thread in region
+// order so the reports come out as if the regions ran one at a time.
+//
+class FactionLog {
+public:
+	void Add(Faction *, int type, const AString &, int item = 0,
+			int force = 0, int full = 0);
+	void Replay();
+
+	AList entries;
+};
+
+// Make l this thread's log, or stop logging with 0; returns the old one
+FactionLog *UseFactionLog(FactionLog *l);
+FactionLog *CurrentFactionLog();
+
 class Faction : public AListElem {
 public:
 	Faction();
@@ -134,6 +153,7 @@ public:
 	/* if attitude == -1, clear it */
 	int GetAttitude(int);
 	void RemoveAttitude(int);
+	void IndexAttitudes();
 	
 	int CanCatch(ARegion *,Unit *);
 	/* Return 1 if can see, 2 if can see faction */
@@ -178,6 +198,7 @@ public:
 	
 	int defaultattitude;
 	AList attitudes;
+	AListIndex attitudeindex; /* attitudes by faction number */
 	SkillList skills;
 	ItemList items;
 	
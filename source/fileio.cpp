@@ -24,15 +24,33 @@
 // END A3HEADER
 #include "fileio.h"
 #include "gameio.h"
+#include "zipfile.h"
+
+#include <sstream>
+#include <string.h>
+#include <ctype.h>
+#include <stdio.h>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define F_ENDLINE '\n'
 
+/* Areport output buffer; a wrapped line never takes more than 80 bytes */
+#define REPORT_BUFSIZE 65536
+#define REPORT_LINEMAX 80
+
 extern long _ftype,_fcreator;
 
 static char buf[1024];
 
 Aoutfile::Aoutfile() {
 	file = new ofstream;
+	binary = 0;
 }
 
 Aoutfile::~Aoutfile() {
@@ -40,15 +58,20 @@ Aoutfile::~Aoutfile() {
 }
 
 Ainfile::Ainfile() {
-	file = new ifstream;
+	data = 0;
+	size = 0;
+	pos = 0;
+	mapped = 0;
+	binary = 0;
 }
 
 Ainfile::~Ainfile() {
-	delete file;
+	Close();
 }
 
 Aorders::Aorders() {
 	file = new ifstream;
+	loaded = 0;
 }
 
 Aorders::~Aorders() {
@@ -57,10 +80,16 @@ Aorders::~Aorders() {
 
 Areport::Areport() {
 	file = new ofstream;
+	buf = new char[REPORT_BUFSIZE];
+	buflen = 0;
+	zip = 0;
+	formats = REPORT_TEXT;
 }
 
 Areport::~Areport() {
+	delete zip;
 	delete file;
+	delete [] buf;
 }
 
 Arules::Arules() {
@@ -82,9 +111,12 @@ void Aoutfile::Open(const AString &s) {
 	}
 }
 
-int Aoutfile::OpenByName(const AString &s) {
+int Aoutfile::OpenByName(const AString &s, int bin) {
 	AString temp = s;
-	file->open(temp.Str(), ios::out|ios::ate);
+	if (bin)
+		file->open(temp.Str(), ios::out|ios::ate|ios::binary);
+	else
+		file->open(temp.Str(), ios::out|ios::ate);
 	if (!file->rdbuf()->is_open()) return -1;
 	// Handle a broke ios::ate implementation on some boxes
 	file->seekp(0, ios::end);
@@ -92,21 +124,87 @@ int Aoutfile::OpenByName(const AString &s) {
 		file->close();
 		return -1;
 	}
+	binary = bin;
+	if (binary) {
+		file->write(BINARY_MAGIC, BINARY_MAGIC_LEN);
+		PutInt(BINARY_FORMAT_VERSION);
+	}
 	return 0;
 }
 
 void Ainfile::Open(const AString &s) {
-	while (!(file->rdbuf()->is_open())) {
+	while (!data) {
 		AString *name = getfilename(s);
-		file->open(name->Str(),ios::in);
+		if (!Load(name->Str()) && CheckBinary() == -1) Close();
 		delete name;
 	}
 }
 
 int Ainfile::OpenByName(const AString &s) {
 	AString temp = s;
-	file->open(temp.Str(),ios::in);
-	if (!(file->rdbuf()->is_open())) return -1;
+	if (Load(temp.Str()) == -1) return -1;
+	if (CheckBinary() == -1) {
+		Close();
+		return -1;
+	}
+	return 0;
+}
+
+//
+// Bring the whole file into memory.  An empty file gets a one byte buffer
+// so that data is only ever null when nothing is open.
+//
+int Ainfile::Load(const char *name) {
+	Close();
+#ifndef WIN32
+	int fd = open(name, O_RDONLY);
+	if (fd == -1) return -1;
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return -1;
+	}
+	if (st.st_size > 0) {
+		void *p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p != MAP_FAILED) {
+			data = (char *) p;
+			size = st.st_size;
+			mapped = 1;
+		}
+	}
+	close(fd);
+	if (mapped) return 0;
+#endif
+	FILE *fp = fopen(name, "rb");
+	if (!fp) return -1;
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	data = new char[size + 1];
+	size = fread(data, 1, size, fp);
+	fclose(fp);
+	return 0;
+}
+
+//
+// Look for the binary magic at the start of a freshly opened file.  If it
+// is there the file is left positioned just past the format version.
+// Returns -1 if the file was written by a newer binary format.
+//
+int Ainfile::CheckBinary() {
+	binary = 0;
+	if (size < BINARY_MAGIC_LEN ||
+			memcmp(data, BINARY_MAGIC, BINARY_MAGIC_LEN)) {
+		return 0;
+	}
+	binary = 1;
+	pos = BINARY_MAGIC_LEN;
+	int version = GetInt();
+	if (version < 1 || version > BINARY_FORMAT_VERSION) {
+		Awrite(AString("Unknown binary file format version ") + version);
+		binary = 0;
+		return -1;
+	}
 	return 0;
 }
 
@@ -115,7 +213,18 @@ void Aoutfile::Close() {
 }
 
 void Ainfile::Close() {
-	file->close();
+	if (data) {
+#ifndef WIN32
+		if (mapped)
+			munmap(data, size);
+		else
+#endif
+			delete [] data;
+	}
+	data = 0;
+	size = 0;
+	pos = 0;
+	mapped = 0;
 }
 
 void Aorders::Close() {
@@ -123,10 +232,16 @@ void Aorders::Close() {
 }
 
 void Areport::Close() {
-	file->close();
+	Flush();
+	if (formats & REPORT_TEXT) file->close();
+	if (zip) {
+		zip->Close();
+		delete zip;
+		zip = 0;
+	}
 }
 
-void skipwhite(ifstream *f) {
+void skipwhite(istream *f) {
 	if (f->eof()) return;
 	int ch = f->peek();
 	while((ch == ' ') || (ch == '\n') || (ch == '\t') ||
@@ -137,37 +252,131 @@ void skipwhite(ifstream *f) {
 	}
 }
 
+static void putword(ofstream *f, unsigned int x) {
+	char b[4];
+	b[0] = (char) (x & 0xff);
+	b[1] = (char) ((x >> 8) & 0xff);
+	b[2] = (char) ((x >> 16) & 0xff);
+	b[3] = (char) ((x >> 24) & 0xff);
+	f->write(b, 4);
+}
+
+int Ainfile::GetWord(unsigned int *x) {
+	if (pos + 4 > size) {
+		pos = size;
+		return 0;
+	}
+	unsigned char *b = (unsigned char *) data + pos;
+	*x = b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int) b[3] << 24);
+	pos += 4;
+	return 1;
+}
+
+const char * Ainfile::GetView(int *len) {
+	*len = 0;
+	if (binary) {
+		unsigned int l;
+		if (!GetWord(&l)) return 0;
+		if (l > (unsigned int) (size - pos)) l = size - pos;
+		const char *ret = data + pos;
+		pos += l;
+		*len = l;
+		return ret;
+	}
+	while (pos < size) {
+		char ch = data[pos];
+		if (ch != ' ' && ch != '\n' && ch != '\t' && ch != '\r' && ch != '\0')
+			break;
+		pos++;
+	}
+	if (pos >= size) return 0;
+	const char *ret = data + pos;
+	const char *end = (const char *) memchr(ret, F_ENDLINE, size - pos);
+	if (end) {
+		*len = end - ret;
+		pos += *len + 1;
+	} else {
+		*len = size - pos;
+		pos = size;
+	}
+	return ret;
+}
+
 AString * Ainfile::GetStr() {
-	skipwhite(file);
-	if (file->peek() == -1 || file->eof()) return 0;
-	file->getline(buf,1023,F_ENDLINE);
-	AString * s = new AString((char *) &(buf[0]));
-	return s;
+	int len;
+	const char *s = GetView(&len);
+	if (!s) return 0;
+	return new AString(s, len);
 }
 
 AString * Ainfile::GetStrNoSkip() {
-	if (file->peek() == -1 || file->eof()) return 0;
-	file->getline(buf,1023,F_ENDLINE);
-	AString * s = new AString((char *) &(buf[0]));
-	return s;
+	if (binary) return GetStr();
+	if (pos >= size) return 0;
+	const char *s = data + pos;
+	const char *end = (const char *) memchr(s, F_ENDLINE, size - pos);
+	int len = end ? end - s : size - pos;
+	pos += len;
+	if (end) pos++;
+	return new AString(s, len);
+}
+
+AString * Ainfile::GetStrOrNone() {
+	int len;
+	const char *s = GetView(&len);
+	if (!s) return 0;
+	if (len == 4 && tolower(s[0]) == 'n' && tolower(s[1]) == 'o' &&
+			tolower(s[2]) == 'n' && tolower(s[3]) == 'e') {
+		return 0;
+	}
+	return new AString(s, len);
 }
 
 int Ainfile::GetInt() {
-	int x;
-	*file >> x;
-	return x;
+	if (binary) {
+		unsigned int x;
+		if (!GetWord(&x)) return 0;
+		return (int) x;
+	}
+	while (pos < size && isspace((unsigned char) data[pos])) pos++;
+	int neg = 0;
+	if (pos < size && (data[pos] == '-' || data[pos] == '+')) {
+		neg = (data[pos] == '-');
+		pos++;
+	}
+	unsigned int x = 0;
+	while (pos < size && data[pos] >= '0' && data[pos] <= '9') {
+		x = x * 10 + (data[pos] - '0');
+		pos++;
+	}
+	return neg ? -(int) x : (int) x;
 }
 
 void Aoutfile::PutInt(int x) {
+	if (binary) {
+		putword(file, (unsigned int) x);
+		return;
+	}
 	*file << x;
 	*file << F_ENDLINE;
 }
 
 void Aoutfile::PutStr(char *s) {
+	if (binary) {
+		int len = strlen(s);
+		putword(file, len);
+		file->write(s, len);
+		return;
+	}
 	*file << s << F_ENDLINE;
 }
 
 void Aoutfile::PutStr(const AString &s) {
+	if (binary) {
+		AString temp = s;
+		putword(file, temp.Len());
+		file->write(temp.Str(), temp.Len());
+		return;
+	}
 	*file << s << F_ENDLINE;
 }
 
@@ -186,12 +395,29 @@ int Aorders::OpenByName(const AString &s) {
 	return 0;
 }
 
+static AString *GetOrdersLine(istream *f, char *line) {
+	skipwhite(f);
+	if (f->eof()) return 0;
+	if (f->peek() == -1) return 0;
+	f->getline(line,1023,F_ENDLINE);
+	AString *s = new AString(line);
+	return s;
+}
+
+int Aorders::Load(const char *text, int len) {
+	istringstream in(string(text, len));
+	char line[1024];
+	AString *str;
+	while ((str = GetOrdersLine(&in, line)))
+		lines.Add(str);
+	loaded = 1;
+	return 0;
+}
+
 AString * Aorders::GetLine() {
-	skipwhite(file);
-	if (file->eof()) return 0;
-	if (file->peek() == -1) return 0;
-	file->getline(buf,1023,F_ENDLINE);
-	AString *s = new AString((char *) &(buf[0]));
+	if (!loaded) return GetOrdersLine(file, buf);
+	AString *s = (AString *) lines.First();
+	if (s) lines.Remove(s);
 	return s;
 }
 
@@ -205,19 +431,34 @@ void Areport::Open(const AString &s) {
 		if ((int)file->tellp()!=0) file->close();
     }
     tabs = 0;
+	buflen = 0;
+	formats = REPORT_TEXT;
 }
 
-int Areport::OpenByName(const AString &s) {
+int Areport::OpenByName(const AString &s, int f) {
 	AString temp = s;
-	file->open(temp.Str(), ios::out|ios::ate);
-    if (!file->rdbuf()->is_open()) return -1;
-	// Handle a broke ios::ate implementation on some boxes
-	file->seekp(0, ios::end);
-	if ((int)file->tellp() != 0) {
-		file->close();
-		return -1;
+	if (f & REPORT_TEXT) {
+		file->open(temp.Str(), ios::out|ios::ate);
+		if (!file->rdbuf()->is_open()) return -1;
+		// Handle a broke ios::ate implementation on some boxes
+		file->seekp(0, ios::end);
+		if ((int)file->tellp() != 0) {
+			file->close();
+			return -1;
+		}
+	}
+	if (f & REPORT_ZIP) {
+		zip = new Azipfile;
+		if (zip->OpenByName(temp + ".zip", temp) == -1) {
+			delete zip;
+			zip = 0;
+			if (f & REPORT_TEXT) file->close();
+			return -1;
+		}
 	}
+	formats = f;
     tabs = 0;
+	buflen = 0;
     return 0;
 }
 
@@ -233,30 +474,89 @@ void Areport::ClearTab() {
 	tabs = 0;
 }
 
+void Areport::Flush() {
+	if (!buflen) return;
+	if (formats & REPORT_TEXT) file->write(buf, buflen);
+	if (zip) zip->Put(buf, buflen);
+	buflen = 0;
+}
+
+void Areport::Write(const char *s, int len) {
+	if (buflen + len > REPORT_BUFSIZE) {
+		Flush();
+		if (len > REPORT_BUFSIZE) {
+			if (formats & REPORT_TEXT) file->write(s, len);
+			if (zip) zip->Put(s, len);
+			return;
+		}
+	}
+	memcpy(buf + buflen, s, len);
+	buflen += len;
+}
+
+//
+// Wraps the line at 70 characters, breaking at the last space among
+// characters 42 to 71 if there is one, and indents the rest by two more
+// spaces.  This is what AString::Trunc(70) did, but the pieces are
+// copied straight into the buffer.  What is left of the line is kept as
+// a number of leading spaces followed by the part of s not yet written.
+//
 void Areport::PutStr(const AString &s,int comment) {
-	AString temp;
-	for (int i=0; i<tabs; i++) temp += "  ";
-	temp += s;
-	AString *temp2 = temp.Trunc(70);
-	if (comment) *file << ";";
-	*file << temp << F_ENDLINE;
-	while (temp2) {
-		temp = "  ";
-		for (int i=0; i<tabs; i++) temp += "  ";
-		temp += *temp2;
-		delete temp2;
-		temp2 = temp.Trunc(70);
-		if (comment) *file << ";";
-		*file << temp << F_ENDLINE;
+	const char *text = ((AString &) s).Str();
+	int len = strlen(text);
+	int lead = 2 * tabs;
+	for (;;) {
+		int cut, skip;
+		if (lead + len <= 70) {
+			cut = lead + len;
+			skip = 0;
+		} else {
+			cut = 70;
+			skip = 0;
+			for (int i = 70; i > 40; i--) {
+				if (i < lead || text[i - lead] == ' ') {
+					cut = i;
+					skip = 1;
+					break;
+				}
+			}
+		}
+		if (buflen + REPORT_LINEMAX > REPORT_BUFSIZE) Flush();
+		char *out = buf + buflen;
+		if (comment) *out++ = ';';
+		if (cut <= lead) {
+			memset(out, ' ', cut);
+		} else {
+			memset(out, ' ', lead);
+			memcpy(out + lead, text, cut - lead);
+		}
+		out += cut;
+		*out++ = F_ENDLINE;
+		buflen = out - buf;
+		if (cut == lead + len) break;
+
+		// What is left of the line, after the indent for the next one
+		cut += skip;
+		if (cut < lead) {
+			lead = lead - cut;
+		} else {
+			text += cut - lead;
+			len -= cut - lead;
+			lead = 0;
+		}
+		lead += 2 + 2 * tabs;
 	}
 }
 
 void Areport::PutNoFormat(const AString &s) {
-	*file << s << F_ENDLINE;
+	const char *text = ((AString &) s).Str();
+	Write(text, strlen(text));
+	EndLine();
 }
 
 void Areport::EndLine() {
-	*file << F_ENDLINE;
+	char endline = F_ENDLINE;
+	Write(&endline, 1);
 }
 
 void Arules::Open(const AString &s) {
@@ -32,6 +32,21 @@
 
 using namespace std;
 
+//
+// Binary snapshot format.  A binary file starts with BINARY_MAGIC followed
+// by BINARY_FORMAT_VERSION; after that every PutInt is a 4 byte little
+// endian integer and every PutStr is a 4 byte length followed by the
+// characters.  Ainfile recognises the magic on open, so the Readin
+// functions work unchanged on either format.
+//
+#define BINARY_MAGIC "\211ATL"
+#define BINARY_MAGIC_LEN 4
+#define BINARY_FORMAT_VERSION 1
+
+//
+// Ainfile maps the whole file into memory (or reads it in one go where mmap
+// is not available) and parses strings and integers in place.
+//
 class Ainfile {
 	public:
 		Ainfile();
@@ -45,7 +60,26 @@ class Ainfile {
 		AString * GetStrNoSkip();
 		int GetInt();
 
-		ifstream * file;
+		//
+		// GetView is GetStr without the copy; it returns a pointer into the
+		// file buffer and the length of the string, which is not NUL
+		// terminated.  GetStrOrNone is GetStr, except that "none" reads as
+		// a null pointer.
+		//
+		const char * GetView(int *len);
+		AString * GetStrOrNone();
+
+		int binary;
+
+	private:
+		int Load(const char *);
+		int CheckBinary();
+		int GetWord(unsigned int *);
+
+		char *data;
+		int size;
+		int pos;
+		int mapped;
 };
 
 class Aoutfile {
@@ -54,7 +88,7 @@ class Aoutfile {
 		~Aoutfile();
 
 		void Open(const AString &);
-		int OpenByName(const AString &);
+		int OpenByName(const AString &, int bin = 0);
 		void Close();
 
 		void PutStr(char *);
@@ -62,6 +96,7 @@ class Aoutfile {
 		void PutInt(int);
 
 		ofstream * file;
+		int binary;
 };
 
 class Aorders {
@@ -73,18 +108,38 @@ class Aorders {
 		int OpenByName(const AString &);
 		void Close();
 
+		//
+		// Load takes the text of an orders file from memory instead of
+		// opening one; GetLine then hands back its lines.
+		//
+		int Load(const char *, int);
+
 		AString * GetLine();
 
 		ifstream * file;
+
+	private:
+		AList lines;
+		int loaded;
 };
 
+/* What Areport::OpenByName writes: the text, a zip of it, or both */
+#define REPORT_TEXT 1
+#define REPORT_ZIP 2
+
+class Azipfile;
+
 class Areport {
 	public:
 		Areport();
 		~Areport();
 
 		void Open(const AString &);
-		int OpenByName(const AString &);
+		//
+		// With REPORT_ZIP, the report also goes into name.zip, as a
+		// file called name.
+		//
+		int OpenByName(const AString &, int formats = REPORT_TEXT);
 		void Close();
 
 		void AddTab();
@@ -97,6 +152,20 @@ class Areport {
 
 		ofstream * file;
 		int tabs;
+
+	private:
+		void Write(const char *, int);
+		void Flush();
+
+		//
+		// The lines are put together here and written out a buffer
+		// at a time.
+		//
+		char *buf;
+		int buflen;
+
+		Azipfile *zip;
+		int formats;
 };
 
 class Arules {
@@ -28,11 +28,20 @@
 #endif
 
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
+#ifndef WIN32
+#include <pthread.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+#include <sstream>
 
 #include "game.h"
 #include "unit.h"
 #include "fileio.h"
+#include "playerindex.h"
 #include "astring.h"
 #include <gamedata.h>
 #include "items.h"
@@ -41,6 +50,9 @@ Game *thisgame;
 
 Game::Game() {
 	gameStatus = GAME_STATUS_UNINIT;
+	seed = 0;
+	threads = 1;
+	reportformats = REPORT_TEXT;
 	ppUnits = 0;
 	maxppunits = 0;
 	thisgame=this;
@@ -56,6 +68,15 @@ int Game::TurnNumber() {
 	return (year-1)*12 + month + 1;
 }
 
+//
+// Seed s for region r in the given phase and make it this thread's
+// random stream.  Returns the stream that was in use before.
+//
+RandomStream *Game::UseRegionStream(RandomStream *s, ARegion *r, int phase) {
+	seedrandomstream(s, seed, TurnNumber(), r->num * RSTREAM_PHASES + phase);
+	return userandomstream(s);
+}
+
 // ALT, 25-Jul-2000
 // Default work order procedure
 void Game::DefaultWorkOrder() {
@@ -388,7 +409,8 @@ int Game::OpenGame(const char * gamefile) {
 		year = f.GetInt();
 
 	month = f.GetInt();
-	seedrandom(f.GetInt());
+	seed = f.GetInt();
+	seedrandom(seed);
 	factionseq = f.GetInt();
 	unitseq = f.GetInt();
 	shipseq = f.GetInt();
@@ -423,49 +445,70 @@ int Game::OpenGame(const char * gamefile) {
 	return 1;
 }
 
-int Game::SaveGame() {
-	return SaveGame("game.out");
+int Game::SaveGame(int binary) {
+	return SaveGame("game.out", binary);
 }
 
-int Game::SaveGame(const char * gamefile) {
+int Game::SaveGame(const char * gamefile, int binary) {
 	Aoutfile f;
-	if (f.OpenByName(gamefile) == -1) return 0;
+	if (f.OpenByName(gamefile, binary) == -1) return 0;
+
+	WriteGame(&f, getrandom(10000));
+
+	f.Close();
+	return 1;
+}
+
+//
+// Rewrite a game file in the text or binary format without running a turn.
+// The random seed is carried over unchanged, so the converted game plays
+// out exactly as the original would.
+//
+int Game::ConvertGame(const char * infile, const char * outfile, int binary) {
+	if (!OpenGame(infile)) return 0;
 
+	Aoutfile f;
+	if (f.OpenByName(outfile, binary) == -1) return 0;
+
+	WriteGame(&f, seed);
+
+	f.Close();
+	return 1;
+}
+
+void Game::WriteGame(Aoutfile *f, int newseed) {
 	//
 	// Write out Globals
 	//
-	f.PutStr("atlantis_game");
-	f.PutInt(CURRENT_ATL_VER);
-	f.PutStr(Globals->RULESET_NAME);
-	f.PutInt(Globals->RULESET_VERSION);
+	f->PutStr("atlantis_game");
+	f->PutInt(CURRENT_ATL_VER);
+	f->PutStr(Globals->RULESET_NAME);
+	f->PutInt(Globals->RULESET_VERSION);
 
 	// mark the fact that we created ocean lairs
-	f.PutInt(-1);
+	f->PutInt(-1);
 
-	f.PutInt(year);
-	f.PutInt(month);
-	f.PutInt(getrandom(10000));
-	f.PutInt(factionseq);
-	f.PutInt(unitseq);
-	f.PutInt(shipseq);
-	f.PutInt(guardfaction);
-	f.PutInt(monfaction);
+	f->PutInt(year);
+	f->PutInt(month);
+	f->PutInt(newseed);
+	f->PutInt(factionseq);
+	f->PutInt(unitseq);
+	f->PutInt(shipseq);
+	f->PutInt(guardfaction);
+	f->PutInt(monfaction);
 
 	//
 	// Write out the Factions
 	//
-	f.PutInt(factions.Num());
+	f->PutInt(factions.Num());
 
 	forlist(&factions)
-		((Faction *) elem)->Writeout(&f);
+		((Faction *) elem)->Writeout(f);
 
 	//
 	// Write out the ARegions
 	//
-	regions.WriteRegions(&f);
-
-	f.Close();
-	return 1;
+	regions.WriteRegions(f);
 }
 
 void Game::DummyGame() {
@@ -501,6 +544,10 @@ int Game::WritePlayers() {
 	}
 
 	f.Close();
+
+	// The index only saves the scripts reading the whole file
+	if (!WritePlayersIndex("players.out"))
+		Awrite("Couldn't write the players index!");
 	return 1;
 }
 
@@ -1018,10 +1065,10 @@ int Game::ReadPlayersLine(AString *pToken, AString *pLine, Faction *pFac,
 									int app = (SkillDefs[sk].flags &
 											SkillType::APPRENTICE);
 									if (mage) {
-										u->type = U_MAGE;
+										u->SetType(U_MAGE);
 									}
 									if (app && u->type == U_NORMAL) {
-										u->type = U_APPRENTICE;
+										u->SetType(U_APPRENTICE);
 									}
 								}
 							}
@@ -1070,7 +1117,8 @@ int Game::ReadPlayersLine(AString *pToken, AString *pLine, Faction *pFac,
 								if (getatsign) {
 									u->oldorders.Add(new AString(saveorder));
 								}
-								ProcessOrder(o, u, pLine, NULL);
+								ATokenizer line(pLine);
+								ProcessOrder(o, u, &line, NULL);
 							}
 						}
 					}
@@ -1106,10 +1154,7 @@ int Game::DoOrdersCheck(const AString &strOrders, const AString &strCheck) {
 		return 0;
 	}
 
-	OrdersCheck check;
-	check.pCheckFile = &checkFile;
-
-	ParseOrders(0, &ordersFile, &check);
+	CheckOrders(&ordersFile, checkFile.file);
 
 	ordersFile.Close();
 	checkFile.Close();
@@ -1117,10 +1162,155 @@ int Game::DoOrdersCheck(const AString &strOrders, const AString &strCheck) {
 	return 1;
 }
 
+//
+// Check one set of orders, writing the results to check.  Orders can
+// leave flags or an open TURN block on the dummy unit, so every check
+// gets a fresh OrdersCheck.
+//
+void Game::CheckOrders(Aorders *orders, ostream *check) {
+	OrdersCheck oc;
+	oc.pCheckFile = check;
+	ParseOrders(0, orders, &oc);
+}
+
+static int CompareNames(const void *a, const void *b) {
+	return strcmp((*(AString **) a)->Str(), (*(AString **) b)->Str());
+}
+
+//
+// Check every orders file in dir, in name order, writing the results for
+// each next to it with ".check" added to the name.  Files that already
+// end in ".check" are left alone, so a directory can be checked again.
+//
+int Game::CheckOrdersDir(const AString &dir) {
+#ifdef WIN32
+	Awrite("Checking a directory is not supported on this system.");
+	return 0;
+#else
+	AString path = dir;
+	DIR *d = opendir(path.Str());
+	if (!d) {
+		Awrite("No such orders directory!");
+		return 0;
+	}
+
+	AList names;
+	struct dirent *ent;
+	while ((ent = readdir(d))) {
+		int len = strlen(ent->d_name);
+		if (ent->d_name[0] == '.') continue;
+		if (len > 6 && !strcmp(ent->d_name + len - 6, ".check")) continue;
+		AString *name = new AString(path + "/" + ent->d_name);
+		struct stat st;
+		if (stat(name->Str(), &st) || !S_ISREG(st.st_mode)) {
+			delete name;
+			continue;
+		}
+		names.Add(name);
+	}
+	closedir(d);
+
+	AString **list = new AString *[names.Num() + 1];
+	int num = 0;
+	{
+		forlist(&names) list[num++] = (AString *) elem;
+	}
+	qsort(list, num, sizeof(AString *), CompareNames);
+
+	int checked = 0;
+	for (int i = 0; i < num; i++) {
+		Aorders ordersFile;
+		if (ordersFile.OpenByName(*list[i]) == -1) {
+			Awrite(AString("Couldn't open ") + *list[i]);
+			continue;
+		}
+		Aoutfile checkFile;
+		if (checkFile.OpenByName(*list[i] + ".check") == -1) {
+			Awrite(AString("Couldn't open ") + *list[i] + ".check");
+			continue;
+		}
+		CheckOrders(&ordersFile, checkFile.file);
+		ordersFile.Close();
+		checkFile.Close();
+		checked++;
+	}
+	delete [] list;
+
+	Awrite(AString("Checked ") + checked + " orders files.");
+	return 1;
+#endif
+}
+
+/* The largest set of orders check-server will take in one piece */
+#define CHECK_STREAM_MAX (1024 * 1024)
+
+//
+// Check orders read from in, one set after another, until it runs out.
+// Each set is a line giving its length in bytes, then that many bytes of
+// orders; each result is written to out the same way.  The length line
+// may end in CR LF.  A set over CHECK_STREAM_MAX bytes is skipped with an
+// error as its result.  Returns 0 if in stops in the middle of a set or
+// has a bad length line.
+//
+int Game::CheckOrdersStream(istream *in, ostream *out) {
+	int size = 1024;
+	char *text = new char[size];
+	char header[32];
+	int ok = 1;
+
+	while (in->getline(header, sizeof(header))) {
+		char *end;
+		long len = strtol(header, &end, 10);
+		if (end != header && *end == '\r') end++;
+		if (end == header || *end || len < 0) {
+			ok = 0;
+			break;
+		}
+		if (len > CHECK_STREAM_MAX) {
+			if (!in->ignore(len) || in->gcount() != len) {
+				ok = 0;
+				break;
+			}
+			AString error = AString("Orders too long: ") + (int) len +
+				" bytes, the most that can be checked is " +
+				CHECK_STREAM_MAX + ".\n";
+			*out << error.Len() << '\n' << error.Str();
+			out->flush();
+			continue;
+		}
+		if (len >= size) {
+			delete [] text;
+			size = len + 1;
+			text = new char[size];
+		}
+		if (!in->read(text, len)) {
+			ok = 0;
+			break;
+		}
+
+		Aorders orders;
+		orders.Load(text, len);
+		ostringstream check;
+		CheckOrders(&orders, &check);
+
+		string result = check.str();
+		*out << result.size() << '\n';
+		out->write(result.data(), result.size());
+		out->flush();
+	}
+	// getline also fails on a length line too long for the buffer
+	if (!in->eof()) ok = 0;
+
+	delete [] text;
+	return ok;
+}
+
 int Game::RunGame() {
+	profile.Phase("PreProcessTurn");
 	Awrite("Setting Up Turn...");
 	PreProcessTurn();
 
+	profile.Phase("ReadPlayers");
 	Awrite("Reading the Gamemaster File...");
 	if (!ReadPlayers()) return 0;
 
@@ -1130,27 +1320,48 @@ int Game::RunGame() {
 	}
 	gameStatus = GAME_STATUS_RUNNING;
 
+	profile.Phase("ReadOrders");
 	Awrite("Reading the Orders File...");
 	ReadOrders();
 
 	if (Globals->MAX_INACTIVE_TURNS != -1) {
+		profile.Phase("RemoveInactiveFactions");
 		Awrite("QUITting Inactive Factions...");
 		RemoveInactiveFactions();
 	}
 
+	profile.Phase(0);
+	profile.turn = TurnNumber();
+	profile.threads = threads;
+	profile.regions = regions.Num();
+	profile.factions = factions.Num();
+	profile.units = 0;
+	forlist(&regions) {
+		ARegion *r = (ARegion *) elem;
+		forlist(&r->objects) {
+			Object *o = (Object *) elem;
+			profile.units += o->units.Num();
+		}
+	}
+
 	Awrite("Running the Turn...");
 	RunOrders();
+	profile.battles = battles.Num();
 
+	profile.Phase("WriteReport");
 	Awrite("Writing the Report File...");
 	WriteReport();
 	Awrite("");
 	battles.DeleteAll();
 
+	profile.Phase("WritePlayers");
 	Awrite("Writing Playerinfo File...");
 	WritePlayers();
 
+	profile.Phase("DeleteDeadFactions");
 	Awrite("Removing Dead Factions...");
 	DeleteDeadFactions();
+	profile.Phase(0);
 	Awrite("done");
 
 	return 1;
@@ -1356,7 +1567,14 @@ void Game::EditGameRegionObjects( ARegion *pReg ) {
 					int i = 0; 
 					AListElem *tmp = pReg->objects.First(); 
 					for (i = 0; i < index; i++) tmp = pReg->objects.Next(tmp); 
-					pReg->objects.Remove(tmp); 
+					Object *obj = (Object *) tmp;
+					forlist(&obj->units) {
+						Unit *u = (Unit *) elem;
+						u->MoveUnit(0);
+						delete u;
+					}
+					pReg->objects.Remove(obj);
+					delete obj;
 				}
 	
 				else if (*pToken == "n") { // rename object 
@@ -1518,11 +1736,11 @@ void Game::EditGameUnitSkills(Unit *pUnit) {
 
 				if ((SkillDefs[skillNum].flags & SkillType::MAGIC) &&
 						(pUnit->type != U_MAGE)) {
-					pUnit->type = U_MAGE;
+					pUnit->SetType(U_MAGE);
 				}
 				if ((SkillDefs[skillNum].flags & SkillType::APPRENTICE) &&
 						(pUnit->type == U_NORMAL)) {
-					pUnit->type = U_APPRENTICE;
+					pUnit->SetType(U_APPRENTICE);
 				}
 				pUnit->skills.SetDays(skillNum, days * pUnit->GetMen());
 				int lvl = pUnit->GetRealSkill(skillNum);
@@ -1581,6 +1799,7 @@ void Game::ClearOrders(Faction * f) {
 }
 
 void Game::ReadOrders() {
+	int read = 0;
 	forlist(&factions) {
 		Faction *fac = (Faction *) elem;
 		if (!fac->IsNPC()) {
@@ -1592,9 +1811,13 @@ void Game::ReadOrders() {
 				ParseOrders(fac->num, &file, 0);
 				file.Close();
 			}
-			DefaultWorkOrder();
+			read = 1;
 		}
 	}
+
+	// This only fills in units left without a month order, so once
+	// after the last faction does what once per faction used to
+	if (read) DefaultWorkOrder();
 }
 
 void Game::MakeFactionReportLists() {
@@ -1635,42 +1858,229 @@ void Game::MakeFactionReportLists() {
 	}
 }
 
-void Game::WriteReport() {
+int Game::WriteFactionReport(Faction *fac) {
 	Areport f;
+	AString str = "report.";
+	str = str + fac->num;
+
+	int i = f.OpenByName(str, reportformats);
+	if (i == -1) return 0;
+	fac->WriteReport(&f, this);
+	f.Close();
+	return 1;
+}
+
+//
+// The report phase only reads the world; everything a report writes to
+// belongs to its own faction.  So the factions can be handed out to a
+// pool of workers, biggest report first, each worker taking the next
+// faction off the queue as soon as it is free.
+//
+struct ReportQueue {
+	Game *game;
+	Faction **facs;
+	int num;
+	int next;
+#ifndef WIN32
+	pthread_mutex_t lock;
+#endif
+};
+
+static Faction *NextReport(ReportQueue *q) {
+	Faction *fac = 0;
+#ifndef WIN32
+	pthread_mutex_lock(&q->lock);
+#endif
+	if (q->next < q->num) fac = q->facs[q->next++];
+#ifndef WIN32
+	pthread_mutex_unlock(&q->lock);
+#endif
+	return fac;
+}
+
+static void *ReportWorker(void *arg) {
+	ReportQueue *q = (ReportQueue *) arg;
+	Faction *fac;
+	while ((fac = NextReport(q)))
+		q->game->WriteFactionReport(fac);
+	return 0;
+}
+
+//
+// Run worker(arg) on up to nthreads threads, counting this one, and wait
+// for them all; 0 means one per processor.  The main thread works too,
+// so the job still gets done if no threads could be started.
+//
+static void RunWorkers(int nthreads, int jobs, void *(*worker)(void *),
+		void *arg) {
+#ifndef WIN32
+	if (nthreads <= 0) nthreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+	if (nthreads > jobs) nthreads = jobs;
+	pthread_t *workers = 0;
+	int started = 0;
+	if (nthreads > 1) {
+		workers = new pthread_t[nthreads - 1];
+		while (started < nthreads - 1 &&
+				!pthread_create(&workers[started], 0, worker, arg))
+			started++;
+	}
+#endif
+	worker(arg);
+#ifndef WIN32
+	for (int i = 0; i < started; i++)
+		pthread_join(workers[i], 0);
+	delete [] workers;
+#endif
+}
+
+static int CompareReportSize(const void *a, const void *b) {
+	Faction *fa = *(Faction **) a;
+	Faction *fb = *(Faction **) b;
+	int na = fa->present_regions.Num();
+	int nb = fb->present_regions.Num();
+	if (na != nb) return nb - na;
+	return fa->num - fb->num;
+}
+
+struct RegionQueue {
+	Game *game;
+	void (Game::*task)(ARegion *);
+	int phase;
+	ARegion **regs;
+	FactionLog *logs;
+	int num;
+	int next;
+#ifndef WIN32
+	pthread_mutex_t lock;
+#endif
+};
 
+static int NextRegion(RegionQueue *q) {
+	int i = -1;
+#ifndef WIN32
+	pthread_mutex_lock(&q->lock);
+#endif
+	if (q->next < q->num) i = q->next++;
+#ifndef WIN32
+	pthread_mutex_unlock(&q->lock);
+#endif
+	return i;
+}
+
+static void *RegionWorker(void *arg) {
+	RegionQueue *q = (RegionQueue *) arg;
+	RandomStream *stream = newrandomstream();
+	int i;
+	while ((i = NextRegion(q)) != -1) {
+		RandomStream *oldstream =
+			q->game->UseRegionStream(stream, q->regs[i], q->phase);
+		FactionLog *oldlog = UseFactionLog(&q->logs[i]);
+		(q->game->*q->task)(q->regs[i]);
+		UseFactionLog(oldlog);
+		userandomstream(oldstream);
+	}
+	deleterandomstream(stream);
+	return 0;
+}
+
+int Game::ParallelRegions() {
+	return Globals->REGION_RANDOM_STREAMS && threads != 1;
+}
+
+FactionLog *Game::RunRegionPhase(void (Game::*task)(ARegion *), int phase) {
+	RegionQueue q;
+	q.game = this;
+	q.task = task;
+	q.phase = phase;
+	q.regs = new ARegion *[regions.Num() + 1];
+	q.logs = new FactionLog[regions.Num() + 1];
+	q.num = 0;
+	q.next = 0;
+	{
+		forlist(&regions) q.regs[q.num++] = (ARegion *) elem;
+	}
+#ifndef WIN32
+	pthread_mutex_init(&q.lock, 0);
+#endif
+	RunWorkers(threads, q.num, RegionWorker, &q);
+#ifndef WIN32
+	pthread_mutex_destroy(&q.lock);
+#endif
+	delete [] q.regs;
+
+	// The tasks skipped this; one call covers the whole phase
+	InvalidateVision();
+	return q.logs;
+}
+
+void Game::WriteReport() {
 	MakeFactionReportLists();
 	CountAllMages();
 	if (Globals->APPRENTICES_EXIST) CountAllApprentices();
 
-	forlist(&factions) {
-	Faction * fac = (Faction *) elem;
-	AString str = "report.";
-	str = str + fac->num;
+	// Build the vision caches up front, so the workers only read them
+	{
+		forlist(&regions) ((ARegion *) elem)->UpdateVision();
+	}
 
-		if (!fac->IsNPC() ||
-		   ((((month == 0) && (year == 1)) || Globals->GM_REPORT) &&
-			(fac->num == 1))) {
-			int i = f.OpenByName(str);
-			if (i != -1) {
-				fac->WriteReport(&f, this);
-				f.Close();
+	ReportQueue q;
+	q.game = this;
+	q.facs = new Faction *[factions.Num() + 1];
+	q.num = 0;
+	q.next = 0;
+	{
+		forlist(&factions) {
+			Faction * fac = (Faction *) elem;
+			if (!fac->IsNPC() ||
+			   ((((month == 0) && (year == 1)) || Globals->GM_REPORT) &&
+				(fac->num == 1))) {
+				q.facs[q.num++] = fac;
 			}
 		}
-//	Adot();
-	cout << fac->num << " " << flush;
+	}
+	qsort(q.facs, q.num, sizeof(Faction *), CompareReportSize);
+
+#ifndef WIN32
+	pthread_mutex_init(&q.lock, 0);
+#endif
+	RunWorkers(threads, q.num, ReportWorker, &q);
+#ifndef WIN32
+	pthread_mutex_destroy(&q.lock);
+#endif
+	delete [] q.facs;
+
+	forlist(&factions) {
+		Faction * fac = (Faction *) elem;
+//		Adot();
+		cout << fac->num << " " << flush;
 	}
 }
 
 void Game::DeleteDeadFactions() {
+	AList dead;
+	AListIndex deadnums;
+	{
+		forlist(&factions) {
+			Faction * fac = (Faction *) elem;
+			if (!fac->IsNPC() && !fac->exists) {
+				factions.Remove(fac);
+				dead.Add(fac);
+				deadnums.Insert(fac->num, fac);
+			}
+		}
+	}
+	if (!dead.Num()) return;
+
+	// One pass over everyone's attitudes drops those to the dead
 	forlist(&factions) {
 		Faction * fac = (Faction *) elem;
-		if (!fac->IsNPC() && !fac->exists) {
-			factions.Remove(fac);
-			forlist((&factions))
-				((Faction *) elem)->RemoveAttitude(fac->num);
-	   		 delete fac;
+		forlist((&fac->attitudes)) {
+			Attitude * a = (Attitude *) elem;
+			if (deadnums.Find(a->factionnum))
+				fac->RemoveAttitude(a->factionnum);
 		}
 	}
+	dead.DeleteAll();
 }
 
 Faction *Game::AddFaction(int newleader) {
@@ -1735,7 +2145,7 @@ void Game::FixGateNums() {
 			// Make sure the hex can have a gate and doesn't already
 			if ((TerrainDefs[tar->type].similar_type==R_OCEAN) || tar->gate)
 				continue;
-			tar->gate = i;
+			regions.SetGate(tar, i);
 			done = 1;
 		}
 	}
@@ -1779,7 +2189,7 @@ void Game::SetupUnitNums() {
 						Awrite(AString("Error: Unit number ") + i +
 							" multiply defined.");
 						if ((unitseq > 0) && (unitseq < maxppunits)) {
-							u->num = unitseq;
+							u->SetNum(unitseq);
 							ppUnits[unitseq++] = u;
 						}
 					}
@@ -1787,7 +2197,7 @@ void Game::SetupUnitNums() {
 					Awrite(AString("Error: Unit number ")+i+
 							" out of range.");
 					if ((unitseq > 0) && (unitseq < maxppunits)) {
-						u->num = unitseq;
+						u->SetNum(unitseq);
 						ppUnits[unitseq++] = u;
 					}
 				}
@@ -2620,7 +3030,7 @@ void Game::CreateCityMon(ARegion *pReg, int percent, int needmage) {
 		else s = new AString("City Guard");
 		u->SetName(s);
 		u->type = U_GUARD;
-		u->guard = GUARD_GUARD;
+		u->SetGuard(GUARD_GUARD);
 		int race;
 		int *gitems;
 		if (Globals->LEADERS_EXIST == GameDefs::RACIAL_LEADERS) {
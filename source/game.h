@@ -33,6 +33,8 @@ class Game;
 #include "faction.h"
 #include "production.h"
 #include "object.h"
+#include "gameio.h"
+#include "profile.h"
 
 #define CURRENT_ATL_VER MAKE_ATL_VER( 4, 0, 11 )
 // change atlantisversion after reorganizing items after testgames
@@ -42,12 +44,13 @@ class OrdersCheck {
 public:
     OrdersCheck();
 
-    Aoutfile *pCheckFile;
+    ostream *pCheckFile;
     Unit dummyUnit;
     Faction dummyFaction;
     Order dummyOrder;
     int numshows;
 
+    void PutStr( const AString &line );
     void Error( const AString &error );
 };
 
@@ -66,8 +69,10 @@ public:
 
     int RunGame();
     int EditGame( int *pSaveGame );
-    int SaveGame();
-	int SaveGame(const char *);
+    int SaveGame(int binary = 0);
+	int SaveGame(const char *, int binary = 0);
+	int ConvertGame(const char *, const char *, int binary);
+	void WriteGame(Aoutfile *, int newseed);
     int WritePlayers();
     int ReadPlayers();
     int ReadPlayersLine( AString *pToken, AString *pLine, Faction *pFac,
@@ -79,6 +84,9 @@ public:
     void UnitFactionMap();
 	int GenRules(const AString &, const AString &, const AString &);
 	int DoOrdersCheck( const AString &strOrders, const AString &strCheck );
+	void CheckOrders( Aorders *orders, ostream *check );
+	int CheckOrdersDir( const AString &dir );
+	int CheckOrdersStream( istream *in, ostream *out );
 
     Faction *AddFaction(int setup=1);
 
@@ -116,9 +124,35 @@ public:
 
     int TurnNumber();
 
+    //
+    // Phases that can draw from per-region random streams when
+    // REGION_RANDOM_STREAMS is set.
+    //
+    enum {
+        RSTREAM_SELL,
+        RSTREAM_BUY,
+        RSTREAM_POSTTURN,
+        RSTREAM_PHASES
+    };
+    RandomStream *UseRegionStream(RandomStream *, ARegion *, int phase);
+
+    //
+    // With region streams on and more than one thread, those phases run
+    // one task per region on a pool of threads.  RunRegionPhase returns
+    // each region's FactionLog, in region order, for the caller to
+    // replay where the serial loop would have run the task.
+    //
+    int ParallelRegions();
+    FactionLog *RunRegionPhase(void (Game::*task)(ARegion *), int phase);
+    void RunSellRegion(ARegion *);
+    void RunBuyRegion(ARegion *);
+    void PostTurnRegion(ARegion *);
+
 	// JLT
 	// Functions to allow enabling/disabling parts of the data tables
 	void ModifyTablesPerRuleset(void);
+	// Index the table names for the parser, once the tables are final
+	void IndexNames();
 
     //
     // Game editing functions.
@@ -142,6 +176,7 @@ public:
     void CountAllMages();
 	void CountAllApprentices();
     void WriteReport();
+    int WriteFactionReport(Faction *);
     void DeleteDeadFactions();
 
     //
@@ -237,7 +272,7 @@ public:
 	void ModifyObjectConstructionBooster(int ob, int item, int bonus);
 	void ModifyObjectManpower(int ob, int prot, int cap, int sail, int mages);
 
-	void Game::ModifyTerrainName(int t, const char * tname);
+	void ModifyTerrainName(int t, const char * tname);
 	void ClearTerrainRaces(int t);
 	void ModifyTerrainRace(int t, int i, int r);
 	void ModifyTerrainCoastRace(int t, int i, int r);
@@ -282,6 +317,10 @@ public:
     int shipseq;
     int year;
     int month;
+    int seed; /* The random seed the game was loaded with */
+    int threads; /* Worker threads for reports and region phases */
+    int reportformats; /* REPORT_TEXT and/or REPORT_ZIP */
+    TurnProfile profile; /* Time spent in each phase of the turn */
 
     enum {
         GAME_STATUS_UNINIT,
@@ -300,72 +339,72 @@ public:
     //
     void ParseError( OrdersCheck *pCheck, Unit *pUnit, Faction *pFac,
                      const AString &strError );
-    UnitId *ParseUnit(AString * s);
+    UnitId *ParseUnit(ATokenizer * s);
     int ParseDir(AString * token);
 
 
     void ParseOrders(int faction, Aorders *ordersFile, OrdersCheck *pCheck );
-    void ProcessOrder( int orderNum, Unit *unit, AString *order,
+    void ProcessOrder( int orderNum, Unit *unit, ATokenizer *order,
                        OrdersCheck *pCheck );
-    void ProcessMoveOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessAdvanceOrder(Unit *,AString *, OrdersCheck *pCheck );
-    Unit *ProcessFormOrder( Unit *former, AString *order,
+    void ProcessMoveOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessAdvanceOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    Unit *ProcessFormOrder( Unit *former, ATokenizer *order,
                             OrdersCheck *pCheck );
-    void ProcessAddressOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessAvoidOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessGuardOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessNameOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessDescribeOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessBehindOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessGiveOrder(Unit *,AString *, OrdersCheck *pCheck );
-	void ProcessWithdrawOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessDeclareOrder(Faction *,AString *, OrdersCheck *pCheck );
-    void ProcessStudyOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessTeachOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessAddressOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessAvoidOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessGuardOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessNameOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessDescribeOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessBehindOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessGiveOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+	void ProcessWithdrawOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessDeclareOrder(Faction *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessStudyOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessTeachOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
     void ProcessWorkOrder(Unit *, OrdersCheck *pCheck );
-    void ProcessProduceOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessBuyOrder( Unit *, AString *, OrdersCheck *pCheck );
-    void ProcessSellOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessAttackOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessBuildOrder( Unit *, AString *, OrdersCheck *pCheck );
-    void ProcessSailOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessTunnelOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessEnterOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessProduceOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessBuyOrder( Unit *, ATokenizer *, OrdersCheck *pCheck );
+    void ProcessSellOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessAttackOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessBuildOrder( Unit *, ATokenizer *, OrdersCheck *pCheck );
+    void ProcessSailOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessTunnelOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessEnterOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
     void ProcessLeaveOrder(Unit *, OrdersCheck *pCheck );
-    void ProcessPromoteOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessEvictOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessPromoteOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessEvictOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
     void ProcessTaxOrder(Unit *, OrdersCheck *pCheck );
     void ProcessPillageOrder(Unit *, OrdersCheck *pCheck );
-    void ProcessConsumeOrder(Unit *, AString *, OrdersCheck *pCheck );
-    void ProcessRevealOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessFindOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessConsumeOrder(Unit *, ATokenizer *, OrdersCheck *pCheck );
+    void ProcessRevealOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessFindOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
     void ProcessDestroyOrder(Unit *, OrdersCheck *pCheck );
-    void ProcessQuitOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessRestartOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessAssassinateOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessStealOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessFactionOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessClaimOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessCombatOrder(Unit *,AString *, OrdersCheck *pCheck );
-	void ProcessPrepareOrder(Unit *, AString *, OrdersCheck *pCheck);
-	void ProcessWeaponOrder(Unit *u, AString *o, OrdersCheck *pCheck);
-	void ProcessArmorOrder(Unit *u, AString *o, OrdersCheck *pCheck);
-    void ProcessCastOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessQuitOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessRestartOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessAssassinateOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessStealOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessFactionOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessClaimOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessCombatOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+	void ProcessPrepareOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
+	void ProcessWeaponOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck);
+	void ProcessArmorOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck);
+    void ProcessCastOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
     void ProcessEntertainOrder(Unit *, OrdersCheck *pCheck );
-    void ProcessForgetOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessReshowOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessHoldOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessNoaidOrder(Unit *,AString *, OrdersCheck *pCheck );
-	void ProcessNocrossOrder(Unit *, AString *, OrdersCheck *pCheck);
-	void ProcessNospoilsOrder(Unit *, AString *, OrdersCheck *pCheck);
-	void ProcessSpoilsOrder(Unit *, AString *, OrdersCheck *pCheck);
-    void ProcessAutoTaxOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessOptionOrder(Unit *,AString *, OrdersCheck *pCheck );
-    void ProcessPasswordOrder(Unit *, AString *, OrdersCheck *pCheck );
-	void ProcessExchangeOrder(Unit *, AString *, OrdersCheck *pCheck);
-	void ProcessIdleOrder(Unit *, AString *, OrdersCheck *pCheck);
+    void ProcessForgetOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessReshowOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessHoldOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessNoaidOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+	void ProcessNocrossOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
+	void ProcessNospoilsOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
+	void ProcessSpoilsOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
+    void ProcessAutoTaxOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessOptionOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
+    void ProcessPasswordOrder(Unit *, ATokenizer *, OrdersCheck *pCheck );
+	void ProcessExchangeOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
+	void ProcessIdleOrder(Unit *, ATokenizer *, OrdersCheck *pCheck);
 	AString *ProcessTurnOrder(Unit *, Aorders *, OrdersCheck *pCheck, int);
-    void ProcessSettleOrder(Unit *,AString *, OrdersCheck *pCheck );
+    void ProcessSettleOrder(Unit *,ATokenizer *, OrdersCheck *pCheck );
 
 	void RemoveInactiveFactions();
 
@@ -605,6 +605,16 @@ public:
 	int MULTIPLE_MAGES_PER_UNIT; // allow several mages per unit
 	int DISABLE_RESTART;	//disallows restart command if setups are done outside of the game.
 
+	// Resolve large volleys of attacks in batches.  The odds are the same,
+	// but random numbers are drawn in a different order, so a turn will
+	// not replay exactly as it does with this off.
+	int BATCHED_ATTACKS;
+
+	// Give each region its own random stream, seeded from the game seed,
+	// turn and region, for the phases that support it.  Those phases
+	// then come out the same whatever order the regions run in.
+	int REGION_RANDOM_STREAMS;
+
 	int CODE_TEST;  // Test a new bit of code
 };
 
@@ -34,6 +34,24 @@ extern "C" {
 
 static randctx isaac_ctx;
 
+class RandomStream {
+	public:
+		randctx ctx;
+		unsigned int base;
+		int pending;	// seeded, but ctx not yet set up from base
+};
+
+// The stream getrandom() draws from on this thread; 0 is the global one.
+static THREAD_LOCAL RandomStream *curstream = 0;
+
+static void SetupStream(RandomStream *);
+
+static inline randctx *CurrentContext() {
+	if (!curstream) return &isaac_ctx;
+	if (curstream->pending) SetupStream(curstream);
+	return &curstream->ctx;
+}
+
 #define ENDLINE '\n'
 char buf[256];
 
@@ -58,7 +76,7 @@ int getrandom(int range) {
 	if (!range) return 0;
 	if (neg) range = -range;
 
-	unsigned long i = isaac_rand(&isaac_ctx);
+	unsigned long i = isaac_rand(CurrentContext());
 	i = i % range;
 
 	if (neg) ret = (int)(i * -1);
@@ -66,6 +84,11 @@ int getrandom(int range) {
 	return ret;
 }
 
+void getrandomwords(unsigned long *words, int num) {
+	randctx *ctx = CurrentContext();
+	for (int i = 0; i < num; i++) words[i] = isaac_rand(ctx);
+}
+
 void seedrandom(int num) {
 	ub4 i;
 	isaac_ctx.randa = isaac_ctx.randb = isaac_ctx.randc = (ub4)0;
@@ -79,6 +102,53 @@ void seedrandomrandom() {
 	seedrandom(time(0));
 }
 
+// Finalizer from MurmurHash3; spreads the stream key over the seed words.
+static unsigned int MixWord(unsigned int h) {
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+	return h;
+}
+
+RandomStream *newrandomstream() {
+	RandomStream *s = new RandomStream;
+	seedrandomstream(s, 0, 0, 0);
+	return s;
+}
+
+//
+// Setting up an ISAAC context costs a few microseconds, and most regions
+// draw nothing in a given phase, so that is left until the first draw.
+//
+void seedrandomstream(RandomStream *s, int seed, int turn, int key) {
+	s->base = MixWord(MixWord(MixWord((unsigned int)seed) ^
+				(unsigned int)turn) ^ (unsigned int)key);
+	s->pending = 1;
+}
+
+static void SetupStream(RandomStream *s) {
+	ub4 i;
+	s->ctx.randa = s->ctx.randb = s->ctx.randc = (ub4)0;
+	for (i=0; i<RANDSIZ; ++i) {
+		s->ctx.randrsl[i] = MixWord(s->base + i);
+	}
+	randinit(&s->ctx, TRUE);
+	s->pending = 0;
+}
+
+void deleterandomstream(RandomStream *s) {
+	if (curstream == s) curstream = 0;
+	delete s;
+}
+
+RandomStream *userandomstream(RandomStream *s) {
+	RandomStream *old = curstream;
+	curstream = s;
+	return old;
+}
+
 int Agetint() {
 	int x;
 	cin >> x;
@@ -34,10 +34,32 @@ void doneIO();
 
 /* Get a random number from 0 to (int-1) */
 int getrandom(int);
+/* Draw a block of raw random words; getrandom(r) is one word % r */
+void getrandomwords(unsigned long *, int);
 /* Seed the random number generator */
 void seedrandom(int);
 void seedrandomrandom();
 
+/*
+ * Independent random streams.  A stream seeded with the same (seed, turn,
+ * key) always gives the same numbers, so work split up by key (a region,
+ * say) replays identically whatever order or thread it runs in.
+ * userandomstream() routes this thread's getrandom() to a stream, or back
+ * to the global generator given 0, and returns the previous stream.
+ */
+class RandomStream;
+RandomStream *newrandomstream();
+void seedrandomstream(RandomStream *, int seed, int turn, int key);
+void deleterandomstream(RandomStream *);
+RandomStream *userandomstream(RandomStream *);
+
+/* Storage class for per-thread state such as the current stream */
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 int Agetint();
 
 void Awrite(const AString &);
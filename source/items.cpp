@@ -48,77 +48,43 @@ static AString DefType(int atype) {
 	return AttType(atype);
 }
 
-int ParseAllItems(AString *token) {
-	int r = -1;
+static NameIndex itemindex;
+
+void IndexItemNames() {
+	itemindex.Clear();
 	for(int i = 0; i < NITEMS; i++) {
 		if ((ItemDefs[i].type & IT_MONSTER) &&
 				ItemDefs[i].index == MONSTER_ILLUSION) {
-			if ((*token == (AString("i") + ItemDefs[i].name)) ||
-				(*token == (AString("i") + ItemDefs[i].names)) ||
-				(*token == (AString("i") + ItemDefs[i].abr))) {
-				r = i;
-				break;
-			}
+			itemindex.Add((AString("i") + ItemDefs[i].name).Str(), i);
+			itemindex.Add((AString("i") + ItemDefs[i].names).Str(), i);
+			itemindex.Add((AString("i") + ItemDefs[i].abr).Str(), i);
 		} else {
-			if ((*token == ItemDefs[i].name) ||
-				(*token == ItemDefs[i].names) ||
-				(*token == ItemDefs[i].abr)) {
-				r = i;
-				break;
-			}
+			itemindex.Add(ItemDefs[i].name, i);
+			itemindex.Add(ItemDefs[i].names, i);
+			itemindex.Add(ItemDefs[i].abr, i);
 		}
 	}
-	return r;
+}
+
+int ParseAllItems(AString *token) {
+	if (!itemindex.Num()) IndexItemNames();
+	return itemindex.Find(token->Str());
 }
 
 int ParseEnabledItem(AString * token) {
-	int r = -1;
-	for (int i=0; i<NITEMS; i++) {
-		if (ItemDefs[i].flags & ItemType::DISABLED) continue;
-		if ((ItemDefs[i].type & IT_MONSTER) &&
-				ItemDefs[i].index == MONSTER_ILLUSION) {
-			if ((*token == (AString("i") + ItemDefs[i].name)) ||
-				(*token == (AString("i") + ItemDefs[i].names)) ||
-				(*token == (AString("i") + ItemDefs[i].abr))) {
-				r = i;
-				break;
-			}
-		} else {
-			if ((*token == ItemDefs[i].name) ||
-				(*token == ItemDefs[i].names) ||
-				(*token == ItemDefs[i].abr)) {
-				r = i;
-				break;
-			}
-		}
-	}
-	if (r != -1) if (ItemDefs[r].flags & ItemType::DISABLED) r = -1;
+	if (!itemindex.Num()) IndexItemNames();
+	int r = itemindex.Find(token->Str());
+	while (r != -1 && (ItemDefs[r].flags & ItemType::DISABLED))
+		r = itemindex.Find(token->Str(), r);
 	return r;
 }
 
 int ParseGiveableItem(AString * token) {
-	int r = -1;
-	for (int i=0; i<NITEMS; i++) {
-		if (ItemDefs[i].flags & ItemType::DISABLED) continue;
-		if (ItemDefs[i].flags & ItemType::CANTGIVE) continue;
-		if ((ItemDefs[i].type & IT_MONSTER) &&
-				ItemDefs[i].index == MONSTER_ILLUSION) {
-			if ((*token == (AString("i") + ItemDefs[i].name)) ||
-				(*token == (AString("i") + ItemDefs[i].names)) ||
-				(*token == (AString("i") + ItemDefs[i].abr))) {
-				r = i;
-				break;
-			}
-		} else {
-			if ((*token == ItemDefs[i].name) ||
-				(*token == ItemDefs[i].names) ||
-				(*token == ItemDefs[i].abr)) {
-				r = i;
-				break;
-			}
-		}
-	}
-	if (r != -1) if (ItemDefs[r].flags & ItemType::DISABLED) r = -1;
+	if (!itemindex.Num()) IndexItemNames();
+	int r = itemindex.Find(token->Str());
+	while (r != -1 && (ItemDefs[r].flags &
+				(ItemType::DISABLED | ItemType::CANTGIVE)))
+		r = itemindex.Find(token->Str(), r);
 	return r;
 }
 
@@ -1153,11 +1119,63 @@ void ItemList::Readin(Ainfile * f) {
 	}
 }
 
-int ItemList::GetNum(int t) {
-	forlist(this) {
-		Item * i = (Item *) elem;
-		if (i->type == t) return i->num;
+ItemList::ItemList() {
+	unitlist = 0;
+	dups = 0;
+}
+
+void ItemList::Add(AListElem * e) {
+	AList::Add(e);
+	if (!index.Insert(((Item *) e)->type, e)) dups = 1;
+}
+
+void ItemList::Insert(AListElem * e) {
+	AList::Insert(e);
+	Item *i = (Item *) e;
+	if (!index.Insert(i->type, i)) {
+		// The new first entry for this type is the one lookups see
+		index.Erase(i->type);
+		index.Insert(i->type, i);
+		dups = 1;
 	}
+}
+
+char ItemList::Remove(AListElem * e) {
+	if (!AList::Remove(e)) return 0;
+	Item *i = (Item *) e;
+	if (index.Find(i->type) == i) {
+		index.Erase(i->type);
+		if (dups) {
+			forlist(this) {
+				if (((Item *) elem)->type == i->type) {
+					index.Insert(i->type, elem);
+					break;
+				}
+			}
+		}
+	}
+	return 1;
+}
+
+void ItemList::DeleteAll() {
+	AList::DeleteAll();
+	index.Clear();
+	dups = 0;
+}
+
+void ItemList::Empty() {
+	AList::Empty();
+	index.Clear();
+	dups = 0;
+}
+
+Item * ItemList::Find(int t) {
+	return (Item *) index.Find(t);
+}
+
+int ItemList::GetNum(int t) {
+	Item *i = Find(t);
+	if (i) return i->num;
 	return 0;
 }
 
@@ -1171,10 +1189,8 @@ int ItemList::Weight() {
 }
 
 int ItemList::CanSell(int t) {
-	forlist(this) {
-		Item *i = (Item *)elem;
-		if (i->type == t) return i->num - i->selling;
-	}
+	Item *i = Find(t);
+	if (i) return i->num - i->selling;
 	return 0;
 }
 
@@ -1230,26 +1246,19 @@ AString ItemList::BattleReport() {
 }
 
 void ItemList::SetNum(int t,int n) {
+	if (unitlist) InvalidateVision();
+	Item * i = Find(t);
 	if (n) {
-		forlist(this) {
-			Item * i = (Item *) elem;
-			if (i->type == t) {
-				i->num = n;
-				return;
-			}
+		if (i) {
+			i->num = n;
+			return;
 		}
-		Item * i = new Item;
+		i = new Item;
 		i->type = t;
 		i->num = n;
 		Add(i);
-	} else {
-		forlist(this) {
-			Item * i = (Item *) elem;
-			if (i->type == t) {
-				Remove(i);
-				delete i;
-				return;
-			}
-		}
+	} else if (i) {
+		Remove(i);
+		delete i;
 	}
 }
@@ -372,6 +372,7 @@ AString AttType(int atype);
 int ParseGiveableItem(AString *);
 int ParseAllItems(AString *);
 int ParseEnabledItem(AString *);
+void IndexItemNames();
 int ParseBattleItem(int);
 
 AString WeapClass(int wclass);
@@ -397,6 +398,8 @@ class Item : public AListElem {
 
 class ItemList : public AList {
 	public:
+		ItemList();
+
 		void Readin(Ainfile *);
 		void Writeout(Aoutfile *);
 
@@ -408,6 +411,22 @@ class ItemList : public AList {
 		void SetNum(int,int); /* type, number */
 		int CanSell(int);
 		void Selling(int, int); /* type, number */
+
+		/* These keep the type index in step with the list */
+		void Add(AListElem *);
+		void Insert(AListElem *);
+		char Remove(AListElem *);
+		void DeleteAll();
+		void Empty();
+
+		/* Set for a unit's items; changes then call InvalidateVision() */
+		int unitlist;
+
+	private:
+		Item * Find(int);
+
+		AListIndex index;
+		int dups; /* Read in with more than one entry for a type */
 };
 
 extern AString ShowSpecial(int special, int level, int expandLevel,
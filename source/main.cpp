@@ -22,15 +22,26 @@
 // http://www.prankster.com/project
 //
 // END A3HEADER
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef WIN32
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
 #include "gamedefs.h"
 #include "game.h"
 #include "items.h"
 #include "skills.h"
+#include "playerindex.h"
 #include <gamedata.h>
 
 void usage() {
 	Awrite("atlantis new");
-	Awrite("atlantis run");
+	Awrite("atlantis run [--binary] [--threads <n>] [--zip|--zip-only]");
+	Awrite("atlantis profile [<runs>] [--binary] [--threads <n>] "
+			"[--zip|--zip-only]");
 	Awrite("atlantis edit");
 	Awrite("");
 	Awrite("atlantis map <type> <mapfile>");
@@ -38,18 +49,125 @@ void usage() {
 	Awrite("atlantis genrules <introfile> <cssfile> <rules-outputfile>");
 	Awrite("");
 	Awrite("atlantis check <orderfile> <checkfile>");
+	Awrite("atlantis check-server <orderdir>|-");
+	Awrite("");
+	Awrite("atlantis convert <infile> <outfile> [--binary]");
+	Awrite("");
+	Awrite("atlantis players [--file <players>] get|set|list|turn|newunit|"
+			"active|index ...");
+}
+
+//
+// Open, run and save one turn, timing each step in game->profile.
+//
+int RunTurn(Game *game, int binary) {
+	game->profile.Phase("OpenGame");
+	if (!game->OpenGame()) {
+		Awrite("Couldn't open the game file!");
+		return 0;
+	}
+
+	if (!game->RunGame()) {
+		Awrite("Couldn't run the game!");
+		return 0;
+	}
+
+	game->profile.Phase("SaveGame");
+	if (!game->SaveGame(binary)) {
+		Awrite("Couldn't save the game!");
+		return 0;
+	}
+	game->profile.Phase(0);
+
+	return 1;
+}
+
+#ifndef WIN32
+static int CopyTurnFile(const AString &from, const AString &to) {
+	AString f = from;
+	AString t = to;
+	FILE *in = fopen(f.Str(), "rb");
+	if (!in) return 0;
+	FILE *out = fopen(t.Str(), "wb");
+	if (!out) {
+		fclose(in);
+		return 0;
+	}
+	char buf[65536];
+	size_t n;
+	int ok = 1;
+	while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+		if (fwrite(buf, 1, n, out) != n) {
+			ok = 0;
+			break;
+		}
+	}
+	if (ferror(in)) ok = 0;
+	fclose(in);
+	if (fclose(out)) ok = 0;
+	return ok;
+}
+
+//
+// Copy game.in, players.in and the orders files from the current
+// directory into dir, which profile then runs the turn in.
+//
+static int CopyTurnFiles(const AString &dir) {
+	AString path = dir;
+	if (!CopyTurnFile("game.in", path + "/game.in")) return 0;
+	if (!CopyTurnFile("players.in", path + "/players.in")) return 0;
+
+	DIR *d = opendir(".");
+	if (!d) return 0;
+	struct dirent *ent;
+	int ok = 1;
+	while (ok && (ent = readdir(d))) {
+		if (strncmp(ent->d_name, "orders.", 7)) continue;
+		struct stat st;
+		if (stat(ent->d_name, &st) || !S_ISREG(st.st_mode)) continue;
+		ok = CopyTurnFile(ent->d_name, path + "/" + ent->d_name);
+	}
+	closedir(d);
+	return ok;
 }
 
+//
+// Remove the profile directory and the files the runs left in it.
+//
+static void RemoveTurnDir(const AString &dir) {
+	AString path = dir;
+	DIR *d = opendir(path.Str());
+	if (d) {
+		struct dirent *ent;
+		while ((ent = readdir(d))) {
+			if (!strcmp(ent->d_name, ".") || !strcmp(ent->d_name, ".."))
+				continue;
+			AString name = path + "/" + ent->d_name;
+			unlink(name.Str());
+		}
+		closedir(d);
+	}
+	rmdir(path.Str());
+}
+#endif
+
 int main(int argc, char *argv[]) {
 	Game game;
 
 	initIO();
 
-	Awrite(AString("Atlantis Engine Version: ") +
-			ATL_VER_STRING(CURRENT_ATL_VER));
-	Awrite(AString(Globals->RULESET_NAME) + ", Version: " +
-			ATL_VER_STRING(Globals->RULESET_VERSION));
-	Awrite("");
+	// Checking orders from stdin and the players queries answer on
+	// stdout, so they get no banner
+	int quiet = (argc == 3 && AString(argv[1]) == "check-server" &&
+			AString(argv[2]) == "-") ||
+			(argc > 1 && AString(argv[1]) == "players");
+	if (!quiet) {
+		Awrite(AString("Atlantis Engine Version: ") +
+				ATL_VER_STRING(CURRENT_ATL_VER));
+		Awrite(AString(Globals->RULESET_NAME) + ", Version: " +
+				ATL_VER_STRING(Globals->RULESET_VERSION));
+		Awrite("");
+	}
 
 	if (argc == 1) {
 		usage();
@@ -57,7 +175,15 @@ int main(int argc, char *argv[]) {
 		return 0;
 	}
 
+	if (AString(argv[1]) == "players") {
+		// These only read and write players.in, so skip the game tables
+		int ok = PlayersCommand(argc - 2, argv + 2);
+		doneIO();
+		return ok ? 0 : 1;
+	}
+
 	game.ModifyTablesPerRuleset();
+	game.IndexNames();
 
 	do {
 		if (AString(argv[1]) == "new") {
@@ -91,20 +217,125 @@ int main(int argc, char *argv[]) {
 				break;
 			}
 		} else if (AString(argv[1]) == "run") {
-			if (!game.OpenGame()) {
-				Awrite("Couldn't open the game file!");
+			int binary = 0;
+			int badargs = 0;
+			for (int i = 2; i < argc; i++) {
+				if (AString(argv[i]) == "--binary") {
+					binary = 1;
+				} else if (AString(argv[i]) == "--threads" && i + 1 < argc) {
+					game.threads = atoi(argv[++i]);
+				} else if (AString(argv[i]) == "--zip") {
+					game.reportformats = REPORT_TEXT | REPORT_ZIP;
+				} else if (AString(argv[i]) == "--zip-only") {
+					game.reportformats = REPORT_ZIP;
+				} else {
+					badargs = 1;
+				}
+			}
+			if (badargs) {
+				usage();
 				break;
 			}
 
-			if (!game.RunGame()) {
-				Awrite("Couldn't run the game!");
+			if (!RunTurn(&game, binary)) break;
+
+			game.profile.Print();
+			if (!game.profile.Write("timing.json")) {
+				Awrite("Couldn't write the timing file!");
+				break;
+			}
+		} else if (AString(argv[1]) == "profile") {
+			//
+			// Run the same turn several times, each time on a fresh copy
+			// of the game loaded from game.in, and report the median time
+			// of each phase.  The runs work in a copy of the turn made in
+			// a temporary directory, so only timing.json is written here.
+			//
+			int runs = 3;
+			int binary = 0;
+			int badargs = 0;
+			for (int i = 2; i < argc; i++) {
+				if (AString(argv[i]) == "--binary") {
+					binary = 1;
+				} else if (AString(argv[i]) == "--threads" && i + 1 < argc) {
+					game.threads = atoi(argv[++i]);
+				} else if (AString(argv[i]) == "--zip") {
+					game.reportformats = REPORT_TEXT | REPORT_ZIP;
+				} else if (AString(argv[i]) == "--zip-only") {
+					game.reportformats = REPORT_ZIP;
+				} else if (i == 2 && atoi(argv[i]) > 0) {
+					runs = atoi(argv[i]);
+				} else {
+					badargs = 1;
+				}
+			}
+			if (badargs) {
+				usage();
 				break;
 			}
 
-			if (!game.SaveGame()) {
-				Awrite("Couldn't save the game!");
+#ifdef WIN32
+			Awrite("Profiling is not supported on this system.");
+			break;
+#else
+			char cwd[4096];
+			if (!getcwd(cwd, sizeof(cwd))) {
+				Awrite("Couldn't find the turn directory!");
+				break;
+			}
+			const char *tmp = getenv("TMPDIR");
+			AString dirname = AString(tmp && *tmp ? tmp : "/tmp") +
+				"/atlantis-profile-XXXXXX";
+			char *dir = new char[dirname.Len() + 1];
+			strcpy(dir, dirname.Str());
+			if (!mkdtemp(dir)) {
+				Awrite("Couldn't make the profile directory!");
+				delete [] dir;
+				break;
+			}
+			if (!CopyTurnFiles(dir) || chdir(dir)) {
+				Awrite("Couldn't copy the turn to the profile directory!");
+				RemoveTurnDir(dir);
+				delete [] dir;
+				break;
+			}
+
+			TurnProfile *profiles = new TurnProfile[runs];
+			TurnProfile **list = new TurnProfile *[runs];
+			int done = 0;
+			for (; done < runs; done++) {
+				Awrite(AString("Profile run ") + (done + 1) + " of " + runs);
+				Game *run = new Game;
+				run->threads = game.threads;
+				run->reportformats = game.reportformats;
+				int ok = RunTurn(run, binary);
+				profiles[done].Copy(&run->profile);
+				list[done] = &profiles[done];
+				delete run;
+				if (!ok) break;
+				Awrite("");
+			}
+
+			int back = chdir(cwd);
+			RemoveTurnDir(dir);
+			delete [] dir;
+			if (back) {
+				Awrite("Couldn't go back to the turn directory!");
+				delete [] list;
+				delete [] profiles;
 				break;
 			}
+
+			if (done == runs) {
+				TurnProfile median;
+				median.Median(list, runs);
+				median.Print();
+				if (!median.Write("timing.json"))
+					Awrite("Couldn't write the timing file!");
+			}
+			delete [] list;
+			delete [] profiles;
+#endif
 		} else if (AString(argv[1]) == "edit") {
 			if (!game.OpenGame()) {
 				Awrite("Couldn't open the game file!");
@@ -134,6 +365,37 @@ int main(int argc, char *argv[]) {
 				Awrite("Couldn't check the orders!");
 				break;
 			}
+		} else if (AString(argv[1]) == "check-server") {
+			//
+			// Check many orders files in one run, with the tables set up
+			// only once: either every file in a directory, or sets of
+			// orders framed by their length on stdin.
+			//
+			if (argc != 3) {
+				usage();
+				break;
+			}
+
+			game.DummyGame();
+			if (quiet) {
+				game.CheckOrdersStream(&cin, &cout);
+			} else if (!game.CheckOrdersDir(argv[2])) {
+				Awrite("Couldn't check the orders!");
+				break;
+			}
+		} else if (AString(argv[1]) == "convert") {
+			int binary = 0;
+			if (argc == 5 && AString(argv[4]) == "--binary") {
+				binary = 1;
+			} else if (argc != 4) {
+				usage();
+				break;
+			}
+
+			if (!game.ConvertGame(argv[2], argv[3], binary)) {
+				Awrite("Couldn't convert the game file!");
+				break;
+			}
 		} else if (AString(argv[1]) == "mapunits") {
 			if (!game.OpenGame()) {
 				Awrite("Couldn't open the game file!");
@@ -72,12 +72,14 @@ void Game::ModifySkillName(int sk, const char * skname) {
 	if (sk < 0 || sk > (NSKILLS-1)) return;
 	SkillDefs[sk].name = new char[strlen(skname)];
 	strcpy (SkillDefs[sk].name,skname);
+	IndexSkillNames();
 }
 
 void Game::ModifySkillAbbr(int sk, const char * skabbr) {
 	if (sk < 0 || sk > (NSKILLS-1)) return;
 	SkillDefs[sk].abbr = new char[strlen(skabbr)];
 	strcpy (SkillDefs[sk].abbr,skabbr);
+	IndexSkillNames();
 }
 
 void Game::EnableItem(int item) {
@@ -98,6 +100,7 @@ void Game::ModifyItemFlags(int it, int flags) {
 void Game::ModifyItemType(int it, int type) {
 	if (it < 0 || it > (NITEMS-1)) return;
 	ItemDefs[it].type = type;
+	IndexItemNames();
 }
 
 void Game::ModifyItemWeight(int it, int weight) {
@@ -193,12 +196,14 @@ void Game::ModifyItemName(int it, const char * itname, const char * itnames) {
         ItemDefs[it].names = new char[strlen(itnames)];
         strcpy (ItemDefs[it].name,itname);
         strcpy (ItemDefs[it].names,itnames);
+        IndexItemNames();
 }
 
 void Game::ModifyItemAbr(int it, const char * itabr) {
         if (it < 0 || it > (NITEMS-1)) return;
         ItemDefs[it].abr = new char[strlen(itabr)];
         strcpy (ItemDefs[it].abr,itabr);
+        IndexItemNames();
 }
 
 void Game::ModifyRaceSkillLevels(int r, int def, int magicdef) {
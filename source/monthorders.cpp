@@ -87,7 +87,7 @@ ARegion * Game::Do1SailOrder(ARegion * reg,Object * ship,Unit * cap) {
 	int slr = 0;
 	forlist(&ship->units) {
 		Unit * unit = (Unit *) elem;
-		if (unit->guard == GUARD_GUARD) unit->guard = GUARD_NONE;
+		if (unit->guard == GUARD_GUARD) unit->SetGuard(GUARD_NONE);
 		if (!GetFaction2(&facs,unit->faction->num)) {
 			FactionPtr * p = new FactionPtr;
 			p->ptr = unit->faction;
@@ -1122,25 +1122,105 @@ void Game::Do1StudyOrder(Unit *u,Object *obj) {
 	}
 }
 
+static int IsMoving(Unit *unit) {
+	return unit->monthorders &&
+		(unit->monthorders->type == O_MOVE ||
+		 unit->monthorders->type == O_ADVANCE);
+}
+
+static int CompareInts(const void *a, const void *b) {
+	return *(int *) a - *(int *) b;
+}
+
+//
+// Fill in the regions that hold a unit from movers, in the order they
+// come in the region list, and return how many there are.  Units that no
+// longer have a move order, or are dead, are dropped from movers.  If
+// phase is not -1, only units due to move in that phase count.
+//
+static int MoverRegions(AList *movers, int *order, ARegion **byorder,
+		int *found, ARegion **out, int phase) {
+	int n = 0;
+	forlist(movers) {
+		UnitPtr *p = (UnitPtr *) elem;
+		Unit *unit = p->ptr;
+		if (!IsMoving(unit) || !unit->object) {
+			movers->Remove(p);
+			delete p;
+			continue;
+		}
+		if (phase != -1 && (unit->movepoints != phase || unit->nomove))
+			continue;
+		found[n++] = order[unit->object->region->num];
+	}
+	qsort(found, n, sizeof(int), CompareInts);
+	int nout = 0;
+	for (int i = 0; i < n; i++) {
+		if (i && found[i] == found[i-1]) continue;
+		out[nout++] = byorder[found[i]];
+	}
+	return nout;
+}
+
 void Game::RunMoveOrders() {
-	for (int phase = 0; phase < Globals->MAX_SPEED; phase++) {
-		{
-			forlist((&regions)) {
-				ARegion * region = (ARegion *) elem;
-				forlist((&region->objects)) {
-					Object * obj = (Object *) elem;
-					forlist(&obj->units) {
-						Unit * unit = (Unit *) elem;
-						Object *tempobj = obj;
-						DoMoveEnter(unit,region,&tempobj);
+	//
+	// Only units with MOVE or ADVANCE orders take part, so find them once
+	// and then each phase only walk the regions they are in.  Those
+	// regions are walked in list order and in full, just as a walk over
+	// the whole world would, so units are handled in the same order.
+	//
+	AList movers;
+	int maxnum = 0;
+	{
+		forlist((&regions)) {
+			ARegion * region = (ARegion *) elem;
+			if (region->num > maxnum) maxnum = region->num;
+			forlist((&region->objects)) {
+				Object * obj = (Object *) elem;
+				forlist(&obj->units) {
+					Unit * unit = (Unit *) elem;
+					if (IsMoving(unit)) {
+						UnitPtr * p = new UnitPtr;
+						p->ptr = unit;
+						movers.Add(p);
 					}
 				}
 			}
 		}
+	}
+	if (!movers.Num()) return;
 
-		AList * locs = new AList;
+	int *order = new int[maxnum + 1];
+	ARegion **byorder = new ARegion *[regions.Num()];
+	int n = 0;
+	{
 		forlist((&regions)) {
 			ARegion * region = (ARegion *) elem;
+			order[region->num] = n;
+			byorder[n++] = region;
+		}
+	}
+	int *found = new int[movers.Num()];
+	ARegion **active = new ARegion *[movers.Num()];
+
+	for (int phase = 0; phase < Globals->MAX_SPEED; phase++) {
+		int nactive = MoverRegions(&movers, order, byorder, found, active, -1);
+		for (int i = 0; i < nactive; i++) {
+			ARegion * region = active[i];
+			forlist((&region->objects)) {
+				Object * obj = (Object *) elem;
+				forlist(&obj->units) {
+					Unit * unit = (Unit *) elem;
+					Object *tempobj = obj;
+					DoMoveEnter(unit,region,&tempobj);
+				}
+			}
+		}
+
+		AList locs;
+		nactive = MoverRegions(&movers, order, byorder, found, active, phase);
+		for (int i = 0; i < nactive; i++) {
+			ARegion * region = active[i];
 			forlist((&region->objects)) {
 				Object * obj = (Object *) elem;
 				forlist(&obj->units) {
@@ -1149,18 +1229,20 @@ void Game::RunMoveOrders() {
 						(unit->monthorders->type == O_MOVE ||
 						 unit->monthorders->type == O_ADVANCE) &&
 						!unit->nomove) {
-						locs->Add(DoAMoveOrder(unit,region,obj));
+						locs.Add(DoAMoveOrder(unit,region,obj));
 					}
 				}
 			}
-/*
-	  DoAdvanceAttacks(locs);
-	  locs->DeleteAll();
-*/
 		}
-		DoAdvanceAttacks(locs);
-		locs->DeleteAll();
+		DoAdvanceAttacks(&locs);
+		locs.DeleteAll();
 	}
+
+	movers.DeleteAll();
+	delete [] order;
+	delete [] byorder;
+	delete [] found;
+	delete [] active;
 }
 
 void Game::DoMoveEnter(Unit * unit,ARegion * region,Object **obj) {
@@ -1261,8 +1343,8 @@ Location * Game::DoAMoveOrder(Unit * unit, ARegion * region, Object * obj) {
 	MoveOrder * o = (MoveOrder *) unit->monthorders;
 	int movetype = unit->MoveType();
 
-	if (unit->guard == GUARD_GUARD) unit->guard = GUARD_NONE;
-	if (o->advancing) unit->guard = GUARD_ADVANCE;
+	if (unit->guard == GUARD_GUARD) unit->SetGuard(GUARD_NONE);
+	if (o->advancing) unit->SetGuard(GUARD_ADVANCE);
 
 	/* Ok, now we can move a region */
 	if (o->dirs.Num()) {
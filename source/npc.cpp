@@ -50,49 +50,18 @@ void Game::CreateLMons() {
 void Game::GrowWMons(int rate) {
 	//
 	// Now, go through each 8x8 block of the map, and make monsters if
-	// needed.
+	// needed.  The sectors keep count of the monsters in, and the monsters
+	// wanted by, their unguarded regions.
 	//
+	if (!regions.sectorsReady) regions.SetupSectors();
 	int level;
 	for(level = 0; level < regions.numLevels; level++) {
 		ARegionArray *pArr = regions.pRegionArrays[ level ];
 		int xsec;
-		for (xsec=0; xsec< pArr->x / 8; xsec++) {
-			for (int ysec=0; ysec< pArr->y / 16; ysec++) {
-				/* OK, we have a sector. Count mons, and wanted */
-				int mons=0;
-				int wanted=0;
-				for (int x=0; x<8; x++) {
-					for (int y=0; y<16; y+=2) {
-						ARegion *reg = pArr->GetRegion(x+xsec*8,y+ysec*16+x%2);
-						if (!reg->IsGuarded()) {
-							mons += reg->CountWMons();
-							/*
-							 * Make sure there is at least one monster type
-							 * enabled for this region
-							 */
-							int avail = 0;
-							int mon = TerrainDefs[reg->type].smallmon;
-							if (!((mon == -1) ||
-								 (ItemDefs[mon].flags & ItemType::DISABLED)))
-								avail = 1;
-							mon = TerrainDefs[reg->type].bigmon;
-							if (!((mon == -1) ||
-								 (ItemDefs[mon].flags & ItemType::DISABLED)))
-								avail = 1;
-							mon = TerrainDefs[reg->type].humanoid;
-							if (!((mon == -1) ||
-								 (ItemDefs[mon].flags & ItemType::DISABLED)))
-								avail = 1;
-
-							if (avail)
-								wanted += TerrainDefs[reg->type].wmonfreq;
-							
-						}
-					}
-				}
-
-				wanted /= 10;
-				wanted -= mons;
+		for (xsec=0; xsec< pArr->xsecs; xsec++) {
+			for (int ysec=0; ysec< pArr->ysecs; ysec++) {
+				ARegionSector *s = &pArr->sectors[xsec + ysec * pArr->xsecs];
+				int wanted = s->wanted / 10 - s->wmons;
 				wanted = (wanted*rate + getrandom(100))/100;
 				if (wanted > 0) {
 					for (int i=0; i< wanted;) {
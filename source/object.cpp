@@ -28,14 +28,17 @@
 #include <gamedata.h>
 #include "unit.h"
 
+static NameIndex objectindex;
+
+void IndexObjectNames() {
+	objectindex.Clear();
+	for (int i=O_DUMMY+1; i<NOBJECTS; i++)
+		objectindex.Add(ObjectDefs[i].name, i);
+}
+
 int ParseObject(AString * token) {
-	int r = -1;
-	for (int i=O_DUMMY+1; i<NOBJECTS; i++) {
-		if (*token == ObjectDefs[i].name) {
-			r = i;
-			break;
-		}
-	}
+	if (!objectindex.Num()) IndexObjectNames();
+	int r = objectindex.Find(token->Str());
 	if (r != -1) {
 		if (ObjectDefs[r].flags & ObjectType::DISABLED) r = -1;
 	}
@@ -95,11 +98,7 @@ void Object::Readin(Ainfile * f,AList * facs,ATL_VER v) {
 
 	if (name) delete name;
 	name = f->GetStr();
-	describe = f->GetStr();
-	if (*describe == "none") {
-		delete describe;
-		describe = 0;
-	}
+	describe = f->GetStrOrNone();
 	inner = f->GetInt();
 	int dummy = f->GetInt();
 	if (dummy == -1) {
@@ -322,9 +321,22 @@ void Object::SetPrevDir(int newdir) {
 }
 
 void Object::MoveObject(ARegion *toreg) {
+	InvalidateVision();
+	{
+		forlist(&units) {
+			Unit *u = (Unit *) elem;
+			region->CountUnit(u, -1);
+		}
+	}
 	region->objects.Remove(this);
 	region = toreg;
 	toreg->objects.Add(this);
+	{
+		forlist(&units) {
+			Unit *u = (Unit *) elem;
+			region->CountUnit(u, 1);
+		}
+	}
 }
 
 int Object::IsRoad() {
@@ -89,6 +89,7 @@ extern ObjectType * ObjectDefs;
 AString *ObjectDescription(int obj);
 
 int ParseObject(AString *);
+void IndexObjectNames();
 
 int ObjectIsShip(int);
 
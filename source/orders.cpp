@@ -92,10 +92,17 @@ char * od[] = {
 
 char ** OrderStrs = od;
 
-int Parse1Order(AString * token) {
+static NameIndex orderindex;
+
+void IndexOrderNames() {
+	orderindex.Clear();
 	for (int i=0; i<NORDERS; i++)
-		if (*token == OrderStrs[i]) return i;
-	return -1;
+		orderindex.Add(OrderStrs[i], i);
+}
+
+int Parse1Order(AString * token) {
+	if (!orderindex.Num()) IndexOrderNames();
+	return orderindex.Find(token->Str());
 }
 
 Order::Order() {
@@ -139,6 +139,7 @@ enum {
 extern char ** OrderStrs;
 
 int Parse1Order(AString *);
+void IndexOrderNames();
 
 class Order : public AListElem {
 	public:
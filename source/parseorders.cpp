@@ -34,21 +34,47 @@ OrdersCheck::OrdersCheck() {
 	dummyUnit.monthorders = 0;
 }
 
+void OrdersCheck::PutStr(const AString &line) {
+	*pCheckFile << line << '\n';
+}
+
 void OrdersCheck::Error(const AString &strError) {
 	if (pCheckFile) {
-		pCheckFile->PutStr("");
-		pCheckFile->PutStr("");
-		pCheckFile->PutStr(AString("*** Error: ") + strError + " ***");
+		PutStr("");
+		PutStr("");
+		PutStr(AString("*** Error: ") + strError + " ***");
 	}
 }
 
-int Game::ParseDir(AString *token) {
+static NameIndex dirindex;
+
+static void IndexDirNames() {
+	dirindex.Clear();
 	for (int i=0; i<NDIRS; i++) {
-		if (*token == DirectionStrs[i]) return i;
-		if (*token == DirectionAbrs[i]) return i;
+		dirindex.Add(DirectionStrs[i], i);
+		dirindex.Add(DirectionAbrs[i], i);
 	}
-	if (*token == "in") return MOVE_IN;
-	if (*token == "out") return MOVE_OUT;
+	dirindex.Add("in", MOVE_IN);
+	dirindex.Add("out", MOVE_OUT);
+}
+
+//
+// Build the name indexes used by the order parser.  The Modify functions
+// rebuild the ones they touch, so this only needs to run once the
+// ruleset has changed the tables, before anything is parsed.
+//
+void Game::IndexNames() {
+	IndexOrderNames();
+	IndexSkillNames();
+	IndexItemNames();
+	IndexObjectNames();
+	IndexDirNames();
+}
+
+int Game::ParseDir(AString *token) {
+	if (!dirindex.Num()) IndexDirNames();
+	int dir = dirindex.Find(token->Str());
+	if (dir != -1) return dir;
 	int num = token->value();
 	if (num) return MOVE_ENTER + num;
 	return -1;
@@ -66,12 +92,11 @@ int ParseTF(AString *token) {
 	return -1;
 }
 
-UnitId *Game::ParseUnit(AString *s) {
+UnitId *Game::ParseUnit(ATokenizer *s) {
 	AString *token = s->gettoken();
 	if (!token) return 0;
 
 	if (*token == "0") {
-		delete token;
 		UnitId *id = new UnitId;
 		id->unitnum = -1;
 		id->alias = 0;
@@ -80,13 +105,11 @@ UnitId *Game::ParseUnit(AString *s) {
 	}
 
 	if (*token == "faction") {
-		delete token;
 		/* Get faction number */
 		token = s->gettoken();
 		if (!token) return 0;
 
 		int fn = token->value();
-		delete token;
 		if (!fn) return 0;
 
 		/* Next token should be "new" */
@@ -94,17 +117,14 @@ UnitId *Game::ParseUnit(AString *s) {
 		if (!token) return 0;
 
 		if (!(*token == "new")) {
-			delete token;
 			return 0;
 		}
-		delete token;
 
 		/* Get alias number */
 		token = s->gettoken();
 		if (!token) return 0;
 
 		int un = token->value();
-		delete token;
 		if (!un) return 0;
 
 		/* Return UnitId */
@@ -116,12 +136,10 @@ UnitId *Game::ParseUnit(AString *s) {
 	}
 
 	if (*token == "new") {
-		delete token;
 		token = s->gettoken();
 		if (!token) return 0;
 
 		int un = token->value();
-		delete token;
 		if (!un) return 0;
 
 		UnitId *id = new UnitId;
@@ -131,7 +149,6 @@ UnitId *Game::ParseUnit(AString *s) {
 		return id;
 	} else {
 		int un = token->value();
-		delete token;
 		if (!un) return 0;
 
 		UnitId *id = new UnitId;
@@ -142,7 +159,7 @@ UnitId *Game::ParseUnit(AString *s) {
 	}
 }
 
-int ParseFactionType(AString *o, int *type) {
+int ParseFactionType(ATokenizer *o, int *type) {
 	int i;
 	for (i=0; i<NFACTYPES; i++) type[i] = 0;
 
@@ -150,7 +167,6 @@ int ParseFactionType(AString *o, int *type) {
 	if (!token) return -1;
 
 	if (*token == "generic") {
-		delete token;
 		for (i=0; i<NFACTYPES; i++) type[i] = 1;
 		return 0;
 	}
@@ -159,17 +175,14 @@ int ParseFactionType(AString *o, int *type) {
 		int foundone = 0;
 		for (i=0; i<NFACTYPES; i++) {
 			if (*token == FactionStrs[i]) {
-				delete token;
 				token = o->gettoken();
 				if (!token) return -1;
 				type[i] = token->value();
-				delete token;
 				foundone = 1;
 				break;
 			}
 		}
 		if (!foundone) {
-			delete token;
 			return -1;
 		}
 		token = o->gettoken();
@@ -195,11 +208,12 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 	Faction *fac = 0;
 	Unit *unit = 0;
 
+	ATokenizer line;
 	AString *order = f->GetLine();
 	while (order) {
-		AString saveorder = *order;
-		int getatsign = order->getat();
-		AString * token = order->gettoken();
+		line.Set(order);
+		int getatsign = line.getat();
+		AString * token = line.gettoken();
 
 		if (token) {
 			int i = Parse1Order(token);
@@ -210,8 +224,7 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 			case O_ATLANTIS:
 				if (fac)
 					ParseError(pCheck, 0, fac, "No #END statement given.");
-				delete token;
-				token = order->gettoken();
+				token = line.gettoken();
 				if (!token) {
 					ParseError(pCheck, 0, 0,
 							"No faction number given on #atlantis line.");
@@ -227,8 +240,7 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 
 				if (!fac) break;
 
-				delete token;
-				token = order->gettoken();
+				token = line.gettoken();
 
 				if (pCheck) {
 					if (!token) {
@@ -288,9 +300,8 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 						unit = former;
 					}
 					unit = 0;
-					delete token;
 
-					token = order->gettoken();
+					token = line.gettoken();
 					if (!token) {
 						ParseError(pCheck,0,fac,"UNIT without unit number.");
 						unit = 0;
@@ -322,7 +333,7 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 							ParseError(pCheck, unit, fac, "FORM: cannot nest.");
 						}
 						else {
-							unit = ProcessFormOrder(unit, order, pCheck);
+							unit = ProcessFormOrder(unit, &line, pCheck);
 							if (!pCheck) {
 								if (unit) unit->ClearOrders();
 							}
@@ -386,27 +397,26 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 				if (fac) {
 					if (unit) {
 						if (!pCheck && getatsign)
-							unit->oldorders.Add(new AString(saveorder));
+							unit->oldorders.Add(new AString(*order));
 
-						ProcessOrder(i, unit, order, pCheck);
+						ProcessOrder(i, unit, &line, pCheck);
 					} else {
 						ParseError(pCheck, 0, fac,
 								"Order given without a unit selected.");
 					}
 				}
 			}
-			SAFE_DELETE(token);
 		} else {
 			if (!pCheck) {
 				if (getatsign && fac && unit)
-					unit->oldorders.Add(new AString(saveorder));
+					unit->oldorders.Add(new AString(*order));
 			}
 		}
 
-		delete order;
 		if (pCheck) {
-			pCheck->pCheckFile->PutStr(saveorder);
+			pCheck->PutStr(*order);
 		}
+		delete order;
 
 		order = f->GetLine();
 	}
@@ -428,7 +438,7 @@ void Game::ParseOrders(int faction, Aorders *f, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessOrder(int orderNum, Unit *unit, AString *o,
+void Game::ProcessOrder(int orderNum, Unit *unit, ATokenizer *o,
 		OrdersCheck *pCheck) {
 	switch(orderNum) {
 		case O_ADDRESS:
@@ -602,13 +612,13 @@ void Game::ProcessOrder(int orderNum, Unit *unit, AString *o,
 	}
 }
 
-void Game::ProcessPasswordOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessPasswordOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	if (pCheck) return;
 
 	AString * token = o->gettoken();
 	if (u->faction->password) delete u->faction->password;
 	if (token) {
-		u->faction->password = token;
+		u->faction->password = new AString(*token);
 		u->faction->Event(AString("Password is now: ") + *token);
 	} else {
 		u->faction->password = new AString("none");
@@ -616,7 +626,7 @@ void Game::ProcessPasswordOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessOptionOrder(Unit * u,ATokenizer *o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "OPTION: What option?");
@@ -624,7 +634,6 @@ void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "times") {
-		delete token;
 		if (!pCheck) {
 			u->faction->Event("Times will be sent to your faction.");
 			u->faction->times = 1;
@@ -633,7 +642,6 @@ void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "notimes") {
-		delete token;
 		if (!pCheck) {
 			u->faction->Event("Times will not be sent to your faction.");
 			u->faction->times = 0;
@@ -642,7 +650,6 @@ void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "template") {
-		delete token;
 
 		token = o->gettoken();
 		if (!token) {
@@ -664,7 +671,6 @@ void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
 		if (*token == "map") {
 			newformat = TEMPLATE_MAP;
 		}
-		delete token;
 
 		if (newformat == -1) {
 			ParseError(pCheck, u, 0, "OPTION: Invalid template type.");
@@ -678,12 +684,11 @@ void Game::ProcessOptionOrder(Unit * u,AString *o, OrdersCheck *pCheck) {
 		return;
 	}
 
-	delete token;
 
 	ParseError(pCheck, u, 0, "OPTION: Invalid option.");
 }
 
-void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessReshowOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		// LLS
@@ -708,7 +713,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "skill") {
-		delete token;
 
 		token = o->gettoken();
 		if (!token) {
@@ -716,7 +720,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 			return;
 		}
 		int sk = ParseSkill(token);
-		delete token;
 
 		if (sk == -1 ||
 				(SkillDefs[sk].flags & SkillType::DISABLED) ||
@@ -732,7 +735,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 			return;
 		}
 		int lvl = token->value();
-		delete token;
 
 		if (!pCheck) {
 			if (lvl > u->faction->skills.GetDays(sk)) {
@@ -746,7 +748,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "item") {
-		delete token;
 		token = o->gettoken();
 
 		if (!token) {
@@ -755,7 +756,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		}
 
 		int item = ParseEnabledItem(token);
-		delete token;
 
 		if (item == -1 || (ItemDefs[item].flags & ItemType::DISABLED)) {
 			ParseError(pCheck, u, 0, "SHOW: No such item.");
@@ -769,7 +769,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "object") {
-		delete token;
 		token = o->gettoken();
 
 		if (!token) {
@@ -778,7 +777,6 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		}
 
 		int obj = ParseObject(token);
-		delete token;
 
 		if (obj == -1 || (ObjectDefs[obj].flags & ObjectType::DISABLED)) {
 			ParseError(pCheck, u, 0, "SHOW: No such object.");
@@ -794,7 +792,7 @@ void Game::ProcessReshowOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	ParseError(pCheck, u, 0, "SHOW: Show what?");
 }
 
-void Game::ProcessForgetOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessForgetOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "FORGET: No skill given.");
@@ -802,7 +800,6 @@ void Game::ProcessForgetOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	int sk = ParseSkill(token);
-	delete token;
 
 	if (sk==-1) {
 		ParseError(pCheck, u, 0, "FORGET: Invalid skill.");
@@ -833,7 +830,7 @@ void Game::ProcessEntertainOrder(Unit * unit, OrdersCheck *pCheck) {
 	unit->monthorders = o;
 }
 
-void Game::ProcessCombatOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessCombatOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		if (!pCheck) {
@@ -843,7 +840,6 @@ void Game::ProcessCombatOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int sk = ParseSkill(token);
-	delete token;
 
 	if (sk==-1) {
 		ParseError(pCheck, u, 0, "COMBAT: Invalid skill.");
@@ -882,7 +878,7 @@ void Game::ProcessCombatOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 }
 
 // Lacandon's prepare command
-void Game::ProcessPrepareOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessPrepareOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	if (!(Globals->USE_PREPARE_COMMAND)) {
 		ParseError(pCheck, u, 0, "PREPARE is not a valid order.");
 		return;
@@ -898,7 +894,6 @@ void Game::ProcessPrepareOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 	int it = ParseEnabledItem(token);
 	int bt = ParseBattleItem(it);
-	delete token;
 
 	if (bt == -1) {
 		ParseError(pCheck, u, 0, "PREPARE: Invalid item.");
@@ -932,7 +927,7 @@ void Game::ProcessPrepareOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessWeaponOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessWeaponOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	if (!(Globals->USE_WEAPON_ARMOR_COMMAND)) {
 		ParseError(pCheck, u, 0, "WEAPON is not a valid order.");
 		return;
@@ -952,7 +947,6 @@ void Game::ProcessWeaponOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	i = 0;
 	while (token && (i < MAX_READY)) {
 		it = ParseEnabledItem(token);
-		delete token;
 		if (it == -1) {
 			ParseError(pCheck, u, 0, "WEAPON: Invalid item.");
 		} else if (!(ItemDefs[it].type & IT_WEAPON)) {
@@ -962,7 +956,6 @@ void Game::ProcessWeaponOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 		}
 		token = o->gettoken();
 	}
-	if (token) delete token;
 	if (pCheck) return;
 
 	while (i < MAX_READY) {
@@ -981,7 +974,7 @@ void Game::ProcessWeaponOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	u->Event(temp);
 }
 
-void Game::ProcessArmorOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessArmorOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	if (!(Globals->USE_WEAPON_ARMOR_COMMAND)) {
 		ParseError(pCheck, u, 0, "ARMOR is not a valid order.");
 		return;
@@ -1001,7 +994,6 @@ void Game::ProcessArmorOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	i = 0;
 	while (token && (i < MAX_READY)) {
 		it = ParseEnabledItem(token);
-		delete token;
 		if (it == -1) {
 			ParseError(pCheck, u, 0, "ARMOR: Invalid item.");
 		} else if (!(ItemDefs[it].type & IT_ARMOR)) {
@@ -1011,7 +1003,6 @@ void Game::ProcessArmorOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 		}
 		token = o->gettoken();
 	}
-	if (token) delete token;
 	if (pCheck) return;
 
 	while (i < MAX_READY) {
@@ -1030,7 +1021,7 @@ void Game::ProcessArmorOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	u->Event(temp);
 }
 
-void Game::ProcessClaimOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessClaimOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "CLAIM: No amount given.");
@@ -1038,7 +1029,6 @@ void Game::ProcessClaimOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	int value = token->value();
-	delete token;
 	if (!value) {
 		ParseError(pCheck, u, 0, "CLAIM: No amount given.");
 		return;
@@ -1055,7 +1045,7 @@ void Game::ProcessClaimOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessFactionOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessFactionOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	if (Globals->FACTION_LIMIT_TYPE != GameDefs::FACLIM_FACTION_TYPES) {
 		ParseError(pCheck, u, 0,
 				"FACTION: Invalid order, no faction types in this game.");
@@ -1112,7 +1102,7 @@ void Game::ProcessFactionOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessAssassinateOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAssassinateOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * id = ParseUnit(o);
 	if (!id || id->unitnum == -1) {
 		ParseError(pCheck, u, 0, "ASSASSINATE: No target given.");
@@ -1126,7 +1116,7 @@ void Game::ProcessAssassinateOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessSettleOrder( Unit * u, AString * o, OrdersCheck * pCheck )
+void Game::ProcessSettleOrder( Unit * u, ATokenizer * o, OrdersCheck * pCheck )
 {
 	if (u->monthorders ||
 		(Globals->TAX_PILLAGE_MONTH_LONG &&
@@ -1142,7 +1132,7 @@ void Game::ProcessSettleOrder( Unit * u, AString * o, OrdersCheck * pCheck )
 	u->monthorders = new SettleOrder;
 }
 
-void Game::ProcessStealOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessStealOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * id = ParseUnit(o);
 	if (!id || id->unitnum == -1) {
 		ParseError(pCheck, u, 0, "STEAL: No target given.");
@@ -1155,7 +1145,6 @@ void Game::ProcessStealOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int i = ParseEnabledItem(token);
-	delete token;
 	if (i == -1) {
 		ParseError(pCheck, u, 0, "STEAL: Bad item given.");
 		delete id;
@@ -1176,7 +1165,7 @@ void Game::ProcessStealOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessQuitOrder(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessQuitOrder(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	if (!pCheck) {
 		if (u->faction->password && !(*(u->faction->password) == "none")) {
 			AString *token = o->gettoken();
@@ -1186,12 +1175,10 @@ void Game::ProcessQuitOrder(Unit *u,AString *o, OrdersCheck *pCheck) {
 			}
 
 			if (!(*token == *(u->faction->password))) {
-				delete token;
 				u->faction->Error("QUIT: Must give the correct password.");
 				return;
 			}
 
-			delete token;
 		}
 
 		if (u->faction->quit != QUIT_AND_RESTART) {
@@ -1200,7 +1187,7 @@ void Game::ProcessQuitOrder(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessRestartOrder(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessRestartOrder(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	if (Globals->DISABLE_RESTART) {
 		u->Error("RESTART: Order is disabled in this game.\nTo restart quit this game and signup again.");
 		return;
@@ -1215,12 +1202,10 @@ void Game::ProcessRestartOrder(Unit *u,AString *o, OrdersCheck *pCheck) {
 			}
 
 			if (!(*token == *(u->faction->password))) {
-				delete token;
 				u->faction->Error("RESTART: Must give the correct password.");
 				return;
 			}
 
-			delete token;
 		}
 
 		if (u->faction->quit != QUIT_AND_RESTART) {
@@ -1242,7 +1227,7 @@ void Game::ProcessDestroyOrder(Unit * u, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessFindOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessFindOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "FIND: No faction number given.");
@@ -1250,7 +1235,6 @@ void Game::ProcessFindOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 	int n = token->value();
 	int is_all = (*token == "all");
-	delete token;
 	if (n==0 && !is_all) {
 		ParseError(pCheck, u, 0, "FIND: No faction number given.");
 		return;
@@ -1262,7 +1246,7 @@ void Game::ProcessFindOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessConsumeOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessConsumeOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 	if (token) {
 		if (*token == "unit") {
@@ -1270,7 +1254,6 @@ void Game::ProcessConsumeOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 				u->SetFlag(FLAG_CONSUMING_UNIT, 1);
 				u->SetFlag(FLAG_CONSUMING_FACTION, 0);
 			}
-			delete token;
 			return;
 		}
 
@@ -1279,7 +1262,6 @@ void Game::ProcessConsumeOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 				u->SetFlag(FLAG_CONSUMING_UNIT, 0);
 				u->SetFlag(FLAG_CONSUMING_FACTION, 1);
 			}
-			delete token;
 			return;
 		}
 
@@ -1288,11 +1270,9 @@ void Game::ProcessConsumeOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 				u->SetFlag(FLAG_CONSUMING_UNIT, 0);
 				u->SetFlag(FLAG_CONSUMING_FACTION, 0);
 			}
-			delete token;
 			return;
 		}
 
-		delete token;
 		ParseError(pCheck, u, 0, "CONSUME: Invalid value.");
 	} else {
 		if (!pCheck) {
@@ -1302,22 +1282,19 @@ void Game::ProcessConsumeOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessRevealOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessRevealOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	if (!pCheck) {
 		AString * token = o->gettoken();
 		if (token) {
 			if (*token == "unit") {
 				u->reveal = REVEAL_UNIT;
-				delete token;
 				return;
 			}
 			if (*token == "faction") {
-				delete token;
 				u->reveal = REVEAL_FACTION;
 				return;
 			}
 			if (*token == "none") {
-				delete token;
 				u->reveal = REVEAL_NONE;
 				return;
 			}
@@ -1361,7 +1338,7 @@ void Game::ProcessPillageOrder(Unit * u, OrdersCheck *pCheck) {
 	u->taxing = TAX_PILLAGE;
 }
 
-void Game::ProcessPromoteOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessPromoteOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * id = ParseUnit(o);
 	if (!id || id->unitnum == -1) {
 		ParseError(pCheck, u, 0, "PROMOTE: No target given.");
@@ -1382,14 +1359,13 @@ void Game::ProcessLeaveOrder(Unit * u, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessEnterOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessEnterOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "ENTER: No object specified.");
 		return;
 	}
 	int i = token->value();
-	delete token;
 	if (i) {
 		if (!pCheck) {
 			u->enter = i;
@@ -1399,12 +1375,11 @@ void Game::ProcessEnterOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessBuildOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessBuildOrder(Unit *unit, ATokenizer *o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (token) {
 		if (*token == "help") {
 			UnitId *targ = 0;
-			delete token;
 			if (!pCheck) {
 				targ = ParseUnit(o);
 				if (!targ) {
@@ -1435,7 +1410,6 @@ void Game::ProcessBuildOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
 		}
 
 		int ot = ParseObject(token);
-		delete token;
 		if (ot==-1) {
 			ParseError(pCheck, unit, 0, "BUILD: Not a valid object name.");
 			return;
@@ -1487,7 +1461,7 @@ void Game::ProcessBuildOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
 	if (unit->enter == -1) unit->enter = 0;
 }
 
-void Game::ProcessAttackOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAttackOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * id = ParseUnit(o);
 	if (!id || id->unitnum == -1) return;
 	AttackOrder * ord = new AttackOrder;
@@ -1502,7 +1476,7 @@ void Game::ProcessAttackOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessSellOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessSellOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "SELL: Number to sell not given.");
@@ -1514,7 +1488,6 @@ void Game::ProcessSellOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	} else {
 		num = token->value();
 	}
-	delete token;
 	if (!num) {
 		ParseError(pCheck, u, 0, "SELL: Number to sell not given.");
 		return;
@@ -1525,7 +1498,6 @@ void Game::ProcessSellOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int it = ParseGiveableItem(token);
-	delete token;
 	if (it == -1) {
 		ParseError(pCheck, u, 0, "SELL: Can't sell that.");
 		return;
@@ -1542,7 +1514,7 @@ void Game::ProcessSellOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessBuyOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessBuyOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "BUY: Number to buy not given.");
@@ -1554,7 +1526,6 @@ void Game::ProcessBuyOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	} else {
 		num = token->value();
 	}
-	delete token;
 	if (!num) {
 		ParseError(pCheck, u, 0, "BUY: Number to buy not given.");
 		return;
@@ -1582,7 +1553,6 @@ void Game::ProcessBuyOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 			}
 		}
 	}
-	delete token;
 	if (it == -1) {
 		ParseError(pCheck, u, 0, "BUY: Can't buy that.");
 		return;
@@ -1600,14 +1570,13 @@ void Game::ProcessBuyOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessProduceOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessProduceOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "PRODUCE: No item given.");
 		return;
 	}
 	int it = ParseEnabledItem(token);
-	delete token;
 
 	if (it == -1) {
 		ParseError(pCheck, u, 0, "PRODUCE: Can't produce that.");
@@ -1651,7 +1620,7 @@ void Game::ProcessWorkOrder(Unit * u, OrdersCheck *pCheck) {
 	u->monthorders = order;
 }
 
-void Game::ProcessTeachOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessTeachOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	TeachOrder * order = 0;
 
 	if (u->monthorders && u->monthorders->type == O_TEACH) {
@@ -1688,14 +1657,13 @@ void Game::ProcessTeachOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	u->monthorders = order;
 }
 
-void Game::ProcessStudyOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessStudyOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, u, 0, "STUDY: No skill given.");
 		return;
 	}
 	int sk = ParseSkill(token);
-	delete token;
 	if (sk==-1) {
 		ParseError(pCheck, u, 0, "STUDY: Invalid skill.");
 		return;
@@ -1728,7 +1696,7 @@ void Game::ProcessStudyOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	u->monthorders = order;
 }
 
-void Game::ProcessDeclareOrder(Faction * f,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessDeclareOrder(Faction * f,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, 0, f, "DECLARE: No faction given.");
@@ -1740,7 +1708,6 @@ void Game::ProcessDeclareOrder(Faction * f,AString * o, OrdersCheck *pCheck) {
 	} else {
 		fac = token->value();
 	}
-	delete token;
 
 	if (!pCheck) {
 		Faction * target;
@@ -1769,7 +1736,6 @@ void Game::ProcessDeclareOrder(Faction * f,AString * o, OrdersCheck *pCheck) {
 	}
 
 	int att = ParseAttitude(token);
-	delete token;
 	if (att == -1) {
 		ParseError(pCheck, 0, f, "DECLARE: Invalid attitude.");
 		return;
@@ -1784,7 +1750,7 @@ void Game::ProcessDeclareOrder(Faction * f,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessWithdrawOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessWithdrawOrder(Unit *unit, ATokenizer *o, OrdersCheck *pCheck) {
 	if (!(Globals->ALLOW_WITHDRAW)) {
 		ParseError(pCheck, unit, 0, "WITHDRAW is not a valid order.");
 		return;
@@ -1799,7 +1765,6 @@ void Game::ProcessWithdrawOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
 	if (amt < 1) {
 		amt = 1;
 	} else {
-		delete token;
 		token = o->gettoken();
 		if (!token) {
 			ParseError(pCheck, unit, 0, "WITHDRAW: No item given.");
@@ -1807,7 +1772,6 @@ void Game::ProcessWithdrawOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
 		}
 	}
 	int item = ParseGiveableItem(token);
-	delete token;
 
 	if (item == -1) {
 		ParseError(pCheck, unit, 0, "WITHDRAW: Invalid item.");
@@ -1845,6 +1809,7 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 	tOrder->repeating = repeat;
 
 	AString *order, *token;
+	ATokenizer line;
 
 	while (turnDepth) {
 		// get the next line
@@ -1853,9 +1818,9 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 			// Fake end of commands to invoke appropriate processing
 			order = new AString("#end");
 		}
-		AString	saveorder = *order;
-		token = order->gettoken();
-		atsign = order->getat();
+		line.Set(order);
+		token = line.gettoken();
+		atsign = line.getat();
 
 		if (token) {
 			int i = Parse1Order(token);
@@ -1866,7 +1831,7 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 						break;
 					}
 					turnDepth++;
-					tOrder->turnOrders.Add(new AString(saveorder));
+					tOrder->turnOrders.Add(new AString(*order));
 					turnLast = 1;
 					break;
 				case O_FORM:
@@ -1876,7 +1841,7 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 					}
 					turnLast = 0;
 					formDepth++;
-					tOrder->turnOrders.Add(new AString(saveorder));
+					tOrder->turnOrders.Add(new AString(*order));
 					break;
 				case O_ENDFORM:
 					if (turnLast) {
@@ -1888,12 +1853,12 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 									"TURN: without ENDTURN.");
 							if (!--turnDepth) {
 								unit->turnorders.Add(tOrder);
-								return new AString(saveorder);
+								return order;
 							}
 						}
 					}
 					formDepth--;
-					tOrder->turnOrders.Add(new AString(saveorder));
+					tOrder->turnOrders.Add(new AString(*order));
 					turnLast = 1;
 					break;
 				case O_UNIT:
@@ -1906,22 +1871,21 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 					}
 					ParseError(pCheck, unit, 0, "TURN: without ENDTURN.");
 					unit->turnorders.Add(tOrder);
-					return new AString(saveorder);
+					return order;
 					break;
 				case O_ENDTURN:
 					if (!turnLast) {
 						ParseError(pCheck, unit, 0, "ENDTURN: without TURN.");
 					} else {
 						if (--turnDepth)
-							tOrder->turnOrders.Add(new AString(saveorder));
+							tOrder->turnOrders.Add(new AString(*order));
 						turnLast = 0;
 					}
 					break;
 				default:
-					tOrder->turnOrders.Add(new AString(saveorder));
+					tOrder->turnOrders.Add(new AString(*order));
 					break;
 			}
-			delete token;
 		}
 		delete order;
 	}
@@ -1931,7 +1895,7 @@ AString *Game::ProcessTurnOrder(Unit * unit, Aorders *f, OrdersCheck *pCheck, in
 	return NULL;
 }
 
-void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
+void Game::ProcessExchangeOrder(Unit * unit, ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * t = ParseUnit(o);
 	if (!t) {
 		ParseError(pCheck, unit, 0, "EXCHANGE: Invalid target.");
@@ -1944,7 +1908,6 @@ void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
 	}
 	int amtGive;
 	amtGive = token->value();
-	delete token;
 
 	if (amtGive < 0) {
 		ParseError(pCheck, unit, 0, "EXCHANGE: Illegal amount given.");
@@ -1958,7 +1921,6 @@ void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
 	}
 	int itemGive;
 	itemGive = ParseGiveableItem(token);
-	delete token;
 
 	if (itemGive == -1) {
 		ParseError(pCheck, unit, 0, "EXCHANGE: Invalid item.");
@@ -1972,7 +1934,6 @@ void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
 	}
 	int amtExpected;
 	amtExpected = token->value();
-	delete token;
 
 	if (amtExpected < 0) {
 		ParseError(pCheck, unit, 0, "EXCHANGE: Illegal amount given.");
@@ -1986,7 +1947,6 @@ void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
 	}
 	int itemExpected;
 	itemExpected = ParseGiveableItem(token);
-	delete token;
 
 	if (itemExpected == -1) {
 		ParseError(pCheck, unit, 0, "EXCHANGE: Invalid item.");
@@ -2004,7 +1964,7 @@ void Game::ProcessExchangeOrder(Unit * unit, AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessGiveOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessGiveOrder(Unit *unit,ATokenizer * o, OrdersCheck *pCheck) {
 	UnitId * t = ParseUnit(o);
 	if (!t) {
 		ParseError(pCheck, unit, 0, "GIVE: Invalid target.");
@@ -2023,7 +1983,6 @@ void Game::ProcessGiveOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 	} else {
 		amt = token->value();
 	}
-	delete token;
 	int item = I_LEADERS;
 	if (amt != -1) {
 		token = o->gettoken();
@@ -2092,14 +2051,12 @@ void Game::ProcessGiveOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 			ParseError(pCheck, unit, 0, "GIVE: No item given.");
 			return;
 		}
-		delete token;
 	}
 
 	token = o->gettoken();
 	int excpt = 0;
 	if (token && *token == "except") {
 		if (amt == -2) {
-			delete token;
 			if (item < 0) {
 				ParseError(pCheck, unit, 0,
 						"GIVE: EXCEPT only valid with specific items.");
@@ -2119,7 +2076,6 @@ void Game::ProcessGiveOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 			ParseError(pCheck, unit, 0, "GIVE: EXCEPT only valid with ALL");
 			return;
 		}
-		delete token;
 	}
 
 	if (!pCheck) {
@@ -2133,23 +2089,21 @@ void Game::ProcessGiveOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 	return;
 }
 
-void Game::ProcessDescribeOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessDescribeOrder(Unit *unit, ATokenizer *o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, unit, 0, "DESCRIBE: No argument.");
 		return;
 	}
 	if (*token == "unit") {
-		delete token;
 		token = o->gettoken();
 		if (!pCheck) {
-			unit->SetDescribe(token);
+			unit->SetDescribe(token ? new AString(*token) : 0);
 		}
 		return;
 	}
 	if (*token == "ship" || *token == "building" || *token == "object" ||
 		*token == "structure") {
-		delete token;
 		token = o->gettoken();
 		if (!pCheck) {
 			// ALT, 25-Jul-2000
@@ -2158,48 +2112,45 @@ void Game::ProcessDescribeOrder(Unit *unit, AString *o, OrdersCheck *pCheck) {
 				unit->Error("DESCRIBE: Unit is not owner.");
 				return;
 			}
-			unit->object->SetDescribe(token);
+			unit->object->SetDescribe(token ? new AString(*token) : 0);
 		}
 		return;
 	}
 	ParseError(pCheck, unit, 0, "DESCRIBE: Can't describe that.");
 }
 
-void Game::ProcessNameOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessNameOrder(Unit *unit,ATokenizer * o, OrdersCheck *pCheck) {
 	AString * token = o->gettoken();
 	if (!token) {
 		ParseError(pCheck, unit, 0, "NAME: No argument.");
 		return;
 	}
 	if (*token == "faction") {
-		delete token;
 		token = o->gettoken();
 		if (!token) {
 			ParseError(pCheck, unit, 0, "NAME: No name given.");
 			return;
 		}
 		if (!pCheck) {
-			unit->faction->SetName(token);
+			unit->faction->SetName(new AString(*token));
 		}
 		return;
 	}
 
 	if (*token == "unit") {
-		delete token;
 		token = o->gettoken();
 		if (!token) {
 			ParseError(pCheck, unit, 0, "NAME: No name given.");
 			return;
 		}
 		if (!pCheck) {
-			unit->SetName(token);
+			unit->SetName(new AString(*token));
 		}
 		return;
 	}
 
 	if (*token == "building" || *token == "ship" || *token == "object" ||
 		*token == "structure") {
-		delete token;
 		token = o->gettoken();
 		if (!token) {
 			ParseError(pCheck, unit, 0, "NAME: No name given.");
@@ -2212,7 +2163,7 @@ void Game::ProcessNameOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 				unit->Error("NAME: Unit is not owner.");
 				return;
 			}
-			unit->object->SetName(token);
+			unit->object->SetName(new AString(*token));
 		}
 		return;
 	}
@@ -2222,7 +2173,6 @@ void Game::ProcessNameOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 	// of tower to rename village, fort to rename town and castle to
 	// rename city.
 	if (*token == "village" || *token == "town" || *token == "city") {
-		delete token;
 		token = o->gettoken();
 
 		if (!token) {
@@ -2309,11 +2259,10 @@ void Game::ProcessNameOrder(Unit *unit,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 
-	delete token;
 	ParseError(pCheck, unit, 0, "NAME: Can't name that.");
 }
 
-void Game::ProcessGuardOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessGuardOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* This is an instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2321,7 +2270,6 @@ void Game::ProcessGuardOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "GUARD: Invalid value.");
 		return;
@@ -2329,14 +2277,14 @@ void Game::ProcessGuardOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	if (!pCheck) {
 		if (val==0) {
 			if (u->guard != GUARD_AVOID)
-				u->guard = GUARD_NONE;
+				u->SetGuard(GUARD_NONE);
 		} else {
-			u->guard = GUARD_SET;
+			u->SetGuard(GUARD_SET);
 		}
 	}
 }
 
-void Game::ProcessBehindOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessBehindOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* This is an instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2353,7 +2301,7 @@ void Game::ProcessBehindOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessNoaidOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessNoaidOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* Instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2361,7 +2309,6 @@ void Game::ProcessNoaidOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "NOAID: Invalid value.");
 		return;
@@ -2371,7 +2318,7 @@ void Game::ProcessNoaidOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessSpoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessSpoilsOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	/* Instant order */
 	AString *token = o->gettoken();
 	int flag = 0;
@@ -2383,7 +2330,6 @@ void Game::ProcessSpoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 		else if (*token == "fly") flag = FLAG_FLYSPOILS;
 		else if (*token == "all") val = 0;
 		else ParseError(pCheck, u, 0, "SPOILS: Bad argument.");
-		delete token;
 	}
 
 	if (!pCheck) {
@@ -2400,7 +2346,7 @@ void Game::ProcessSpoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessNospoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessNospoilsOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	ParseError(pCheck, u, 0, "NOSPOILS: This command is deprecated.  "
 			"Use the 'SPOILS' command instead");
 
@@ -2411,7 +2357,6 @@ void Game::ProcessNospoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "NOSPILS: Invalid value.");
 		return;
@@ -2424,7 +2369,7 @@ void Game::ProcessNospoilsOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessNocrossOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessNocrossOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	int move_over_water = 0;
 
 	if (Globals->FLIGHT_OVER_WATER != GameDefs::WFLIGHT_NONE)
@@ -2448,7 +2393,6 @@ void Game::ProcessNocrossOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "NOCROSS: Invalid value.");
 		return;
@@ -2459,7 +2403,7 @@ void Game::ProcessNocrossOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 }
 
 
-void Game::ProcessHoldOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessHoldOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* Instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2467,7 +2411,6 @@ void Game::ProcessHoldOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "HOLD: Invalid value.");
 		return;
@@ -2477,7 +2420,7 @@ void Game::ProcessHoldOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessAutoTaxOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAutoTaxOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* Instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2485,7 +2428,6 @@ void Game::ProcessAutoTaxOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "AUTOTAX: Invalid value.");
 		return;
@@ -2495,7 +2437,7 @@ void Game::ProcessAutoTaxOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessAvoidOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAvoidOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* This is an instant order */
 	AString * token = o->gettoken();
 	if (!token) {
@@ -2503,23 +2445,22 @@ void Game::ProcessAvoidOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int val = ParseTF(token);
-	delete token;
 	if (val==-1) {
 		ParseError(pCheck, u, 0, "AVOID: Invalid value.");
 		return;
 	}
 	if (!pCheck) {
 		if (val==1) {
-			u->guard = GUARD_AVOID;
+			u->SetGuard(GUARD_AVOID);
 		} else {
 			if (u->guard == GUARD_AVOID) {
-				u->guard = GUARD_NONE;
+				u->SetGuard(GUARD_NONE);
 			}
 		}
 	}
 }
 
-Unit *Game::ProcessFormOrder(Unit *former, AString *o, OrdersCheck *pCheck) {
+Unit *Game::ProcessFormOrder(Unit *former, ATokenizer *o, OrdersCheck *pCheck) {
 	AString *t = o->gettoken();
 	if (!t) {
 		ParseError(pCheck, former, 0, "Must give alias in FORM order.");
@@ -2527,7 +2468,6 @@ Unit *Game::ProcessFormOrder(Unit *former, AString *o, OrdersCheck *pCheck) {
 	}
 
 	int an = t->value();
-	delete t;
 	if (!an) {
 		ParseError(pCheck, former, 0, "Must give alias in FORM order.");
 		return 0;
@@ -2550,19 +2490,19 @@ Unit *Game::ProcessFormOrder(Unit *former, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessAddressOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAddressOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	/* This is an instant order */
 	AString * token = o->gettoken();
 	if (token) {
 		if (!pCheck) {
-			u->faction->address = token;
+			u->faction->address = new AString(*token);
 		}
 	} else {
 		ParseError(pCheck, u, 0, "ADDRESS: No address given.");
 	}
 }
 
-void Game::ProcessAdvanceOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessAdvanceOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	MoveOrder *m = 0;
 
 	if ((u->monthorders && u->monthorders->type != O_ADVANCE) ||
@@ -2587,7 +2527,6 @@ void Game::ProcessAdvanceOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		AString * t = o->gettoken();
 		if (!t) return;
 		int d = ParseDir(t);
-		delete t;
 		if (d!=-1) {
 			if (!pCheck) {
 				MoveDir * x = new MoveDir;
@@ -2601,7 +2540,7 @@ void Game::ProcessAdvanceOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessTunnelOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessTunnelOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	TunnelOrder *order = new TunnelOrder();
 
 	AString * token = o->gettoken();
@@ -2610,7 +2549,6 @@ void Game::ProcessTunnelOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		return;
 	}
 	int dir = ParseDir(token);
-	delete token;
 	if( dir == -1 ) {
 		ParseError(pCheck, u, 0, "TUNNEL: Bad direction.");
 		return;
@@ -2631,7 +2569,7 @@ void Game::ProcessTunnelOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	u->monthorders = order;
 }
 
-void Game::ProcessMoveOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessMoveOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	MoveOrder *m = 0;
 
 	if ((u->monthorders && u->monthorders->type != O_MOVE) ||
@@ -2655,7 +2593,6 @@ void Game::ProcessMoveOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		AString * t = o->gettoken();
 		if (!t) return;
 		int d = ParseDir(t);
-		delete t;
 		if (d!=-1) {
 			if (!pCheck) {
 				MoveDir * x = new MoveDir;
@@ -2669,7 +2606,7 @@ void Game::ProcessMoveOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessSailOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessSailOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	SailOrder *m = 0;
 
 	if ((u->monthorders && u->monthorders->type != O_SAIL) ||
@@ -2692,7 +2629,6 @@ void Game::ProcessSailOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 		AString * t = o->gettoken();
 		if (!t) return;
 		int d = ParseDir(t);
-		delete t;
 		if (d == -1) {
 			ParseError(pCheck, u, 0, "SAIL: Warning, bad direction.");
 			return;
@@ -2710,7 +2646,7 @@ void Game::ProcessSailOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessEvictOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
+void Game::ProcessEvictOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck) {
 	UnitId * id = ParseUnit(o);
 	while (id && id->unitnum != -1) {
 		if (!pCheck) {
@@ -2721,7 +2657,7 @@ void Game::ProcessEvictOrder(Unit *u, AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessIdleOrder(Unit *u, AString *o, OrdersCheck *pCheck)
+void Game::ProcessIdleOrder(Unit *u, ATokenizer *o, OrdersCheck *pCheck)
 {
 	if (u->monthorders || (Globals->TAX_PILLAGE_MONTH_LONG &&
 		((u->taxing == TAX_TAX) || (u->taxing == TAX_PILLAGE)))) {
@@ -0,0 +1,719 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#include "playerindex.h"
+#include "gameio.h"
+
+#include <fstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef WIN32
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+struct PlayersIndex {
+	int size;
+	long long ino;
+	long long mtime;
+	int mtimens;
+	int turn;
+	int newunit;
+	int active;
+	int count;
+	int *entries;	/* number, offset and length of each faction */
+};
+
+static void PutWord(char *p, unsigned int x) {
+	p[0] = (char) (x & 0xff);
+	p[1] = (char) ((x >> 8) & 0xff);
+	p[2] = (char) ((x >> 16) & 0xff);
+	p[3] = (char) ((x >> 24) & 0xff);
+}
+
+static int GetWord(const char *p) {
+	const unsigned char *u = (const unsigned char *) p;
+	return (int) (u[0] | (u[1] << 8) | (u[2] << 16) |
+			((unsigned int) u[3] << 24));
+}
+
+//
+// The size, inode and modification time (to the nanosecond, where the
+// system keeps it) of an open players file, to tell whether its index
+// was made from it.  A set replaces the file, so the inode changes even
+// if the size and time do not.
+//
+static int FileStamp(FILE *f, PlayersIndex *idx) {
+	struct stat st;
+	if (fstat(fileno(f), &st)) return 0;
+	idx->size = (int) st.st_size;
+	idx->ino = (long long) st.st_ino;
+	idx->mtime = (long long) st.st_mtime;
+#ifdef WIN32
+	idx->mtimens = 0;
+#else
+	idx->mtimens = (int) st.st_mtim.tv_nsec;
+#endif
+	return 1;
+}
+
+static FILE *OpenPlayersFile(const AString &players) {
+	AString name = players;
+	return fopen(name.Str(), "rb");
+}
+
+//
+// Read the whole of an open players file into a new buffer, with a '\0'
+// after it, and stamp it.
+//
+static char *ReadPlayersFile(FILE *f, int *len, PlayersIndex *idx) {
+	if (!FileStamp(f, idx)) return 0;
+	int size = idx->size;
+	char *buf = new char[size + 1];
+	if (fseek(f, 0, SEEK_SET) ||
+			fread(buf, 1, size, f) != (size_t) size) {
+		delete [] buf;
+		return 0;
+	}
+	buf[size] = '\0';
+	*len = size;
+	return buf;
+}
+
+//
+// Find the end of the line at s; returns the start of the next line.
+//
+static const char *NextLine(const char *s, const char *end, int *linelen) {
+	const char *e = (const char *) memchr(s, '\n', end - s);
+	if (!e) e = end;
+	int n = e - s;
+	if (n && s[n - 1] == '\r') n--;
+	*linelen = n;
+	return e < end ? e + 1 : end;
+}
+
+//
+// If the line starts with key, as the engine would read it, put the rest
+// of the line in value and return 1.
+//
+static int LineKey(const char *s, int n, const AString &key, AString *value) {
+	char token[64];
+	int i = 0;
+	while (i < n && i < 63 && s[i] != ' ' && s[i] != '\t') {
+		token[i] = s[i];
+		i++;
+	}
+	token[i] = '\0';
+	if (!(AString(token) == key)) return 0;
+	while (i < n && (s[i] == ' ' || s[i] == '\t')) i++;
+	if (value) {
+		char *rest = new char[n - i + 1];
+		memcpy(rest, s + i, n - i);
+		rest[n - i] = '\0';
+		*value = rest;
+		delete [] rest;
+	}
+	return 1;
+}
+
+static int CompareEntries(const void *a, const void *b) {
+	return *(const int *) a - *(const int *) b;
+}
+
+//
+// Work out the index of a players file already read into buf.  Factions
+// still to be added ("Faction: new") have no number and are left out.
+//
+static void ScanPlayers(const char *buf, int len, PlayersIndex *idx) {
+	const char *end = buf + len;
+	int room = 64;
+	idx->size = len;
+	idx->turn = 0;
+	idx->newunit = 0;
+	idx->active = 0;
+	idx->count = 0;
+	idx->entries = new int[room * 3];
+
+	int *cur = 0;
+	int faction = 0;
+	const char *s = buf;
+	while (s < end) {
+		int n;
+		const char *next = NextLine(s, end, &n);
+		AString value;
+		if (LineKey(s, n, "Faction:", &value)) {
+			if (cur) cur[2] = (s - buf) - cur[1];
+			cur = 0;
+			faction = 1;
+			int num = value.value();
+			if (num > 0) {
+				if (idx->count == room) {
+					int *grown = new int[room * 2 * 3];
+					memcpy(grown, idx->entries, room * 3 * sizeof(int));
+					delete [] idx->entries;
+					idx->entries = grown;
+					room *= 2;
+				}
+				cur = idx->entries + 3 * idx->count++;
+				cur[0] = num;
+				cur[1] = s - buf;
+			}
+		} else if (!faction && LineKey(s, n, "TurnNumber:", &value)) {
+			idx->turn = value.value();
+		} else if (cur && LineKey(s, n, "LastOrders:", &value)) {
+			if (value.value() == idx->turn) idx->active++;
+		} else if (LineKey(s, n, "NewUnit:", &value)) {
+			if (value.value() > idx->newunit) idx->newunit = value.value();
+		}
+		s = next;
+	}
+	if (cur) cur[2] = len - cur[1];
+	idx->newunit++;
+	qsort(idx->entries, idx->count, 3 * sizeof(int), CompareEntries);
+}
+
+static int *FindEntry(PlayersIndex *idx, int num) {
+	int key[3];
+	key[0] = num;
+	return (int *) bsearch(key, idx->entries, idx->count, 3 * sizeof(int),
+			CompareEntries);
+}
+
+#ifndef WIN32
+//
+// Take the lock that keeps sets to the players file one at a time.  The
+// file is replaced, not rewritten, so once the lock is held check that it
+// is still the file of that name, and lock the new one if not.  Returns
+// the descriptor holding the lock, or -1.
+//
+static int LockPlayersFile(const AString &players) {
+	AString name = players;
+	for (;;) {
+		int fd = open(name.Str(), O_RDONLY);
+		if (fd == -1) return -1;
+		if (flock(fd, LOCK_EX) == -1) {
+			close(fd);
+			return -1;
+		}
+		struct stat locked, named;
+		if (!fstat(fd, &locked) && !stat(name.Str(), &named) &&
+				locked.st_dev == named.st_dev &&
+				locked.st_ino == named.st_ino)
+			return fd;
+		close(fd);
+	}
+}
+#endif
+
+//
+// Write the index for the players file.  The caller holds the players
+// file lock, so the file can't be replaced while it is read and stamped.
+//
+static int WriteIndexLocked(const AString &players) {
+	FILE *pf = OpenPlayersFile(players);
+	if (!pf) return 0;
+	int len;
+	PlayersIndex idx;
+	char *buf = ReadPlayersFile(pf, &len, &idx);
+	fclose(pf);
+	if (!buf) return 0;
+	ScanPlayers(buf, len, &idx);
+	delete [] buf;
+
+	int size = PLAYERS_INDEX_HEADER + idx.count * PLAYERS_INDEX_ENTRY;
+	char *out = new char[size];
+	memcpy(out, PLAYERS_INDEX_MAGIC, 4);
+	PutWord(out + 4, PLAYERS_INDEX_VERSION);
+	PutWord(out + 8, idx.size);
+	PutWord(out + 12, idx.turn);
+	PutWord(out + 16, idx.newunit);
+	PutWord(out + 20, idx.active);
+	PutWord(out + 24, idx.count);
+	PutWord(out + 28, (unsigned int) (idx.ino & 0xffffffff));
+	PutWord(out + 32, (unsigned int) (idx.ino >> 32));
+	PutWord(out + 36, (unsigned int) (idx.mtime & 0xffffffff));
+	PutWord(out + 40, (unsigned int) (idx.mtime >> 32));
+	PutWord(out + 44, idx.mtimens);
+	for (int i = 0; i < idx.count * 3; i++)
+		PutWord(out + PLAYERS_INDEX_HEADER + 4 * i, idx.entries[i]);
+	delete [] idx.entries;
+
+	//
+	// Write it under another name and move it into place, so a script
+	// never finds half an index.
+	//
+	AString name = players;
+	name += ".idx";
+	AString temp = name + ".new";
+	ofstream f(temp.Str(), ios::out | ios::trunc | ios::binary);
+	if (!f.is_open()) {
+		delete [] out;
+		return 0;
+	}
+	f.write(out, size);
+	f.close();
+	delete [] out;
+	if (f.fail()) return 0;
+#ifdef WIN32
+	remove(name.Str());
+#endif
+	return !rename(temp.Str(), name.Str());
+}
+
+int WritePlayersIndex(const AString &players) {
+#ifndef WIN32
+	int lock = LockPlayersFile(players);
+	if (lock == -1) return 0;
+#endif
+	int ok = WriteIndexLocked(players);
+#ifndef WIN32
+	close(lock);
+#endif
+	return ok;
+}
+
+//
+// Read the header of the index for the open players file f, if there is
+// an index and it was made from exactly this file, and leave *x open on
+// it for reading the entries.
+//
+static int ReadIndexHeader(const AString &players, FILE *f, FILE **x,
+		PlayersIndex *idx) {
+	if (!FileStamp(f, idx)) return 0;
+
+	AString name = players;
+	name += ".idx";
+	*x = fopen(name.Str(), "rb");
+	if (!*x) return 0;
+	char h[PLAYERS_INDEX_HEADER];
+	if (fread(h, 1, PLAYERS_INDEX_HEADER, *x) != PLAYERS_INDEX_HEADER) {
+		fclose(*x);
+		*x = 0;
+		return 0;
+	}
+	long long ino = (unsigned int) GetWord(h + 28) |
+		((long long) GetWord(h + 32) << 32);
+	long long mtime = (unsigned int) GetWord(h + 36) |
+		((long long) GetWord(h + 40) << 32);
+	if (memcmp(h, PLAYERS_INDEX_MAGIC, 4) ||
+			GetWord(h + 4) != PLAYERS_INDEX_VERSION ||
+			GetWord(h + 8) != idx->size || ino != idx->ino ||
+			mtime != idx->mtime || GetWord(h + 44) != idx->mtimens ||
+			GetWord(h + 24) < 0 || GetWord(h + 24) > idx->size) {
+		fclose(*x);
+		*x = 0;
+		return 0;
+	}
+	idx->turn = GetWord(h + 12);
+	idx->newunit = GetWord(h + 16);
+	idx->active = GetWord(h + 20);
+	idx->count = GetWord(h + 24);
+	idx->entries = 0;
+	return 1;
+}
+
+//
+// Read the index for the open players file f, entries and all, if it is
+// up to date.
+//
+static int ReadIndex(const AString &players, FILE *f, PlayersIndex *idx) {
+	FILE *x;
+	if (!ReadIndexHeader(players, f, &x, idx)) return 0;
+	int n = idx->count * 3;
+	char *e = new char[n * 4 + 1];
+	int ok = (fread(e, 4, n, x) == (size_t) n);
+	fclose(x);
+	if (ok) {
+		idx->entries = new int[n + 1];
+		for (int i = 0; i < n; i++) idx->entries[i] = GetWord(e + 4 * i);
+	}
+	delete [] e;
+	return ok;
+}
+
+//
+// The lines of one faction from the players file, in a new buffer.  With
+// an up to date index this reads the header, a few entries and the lines
+// themselves; otherwise it reads the whole file.  Returns 0 if there is
+// no such faction.
+//
+static char *GetFactionLines(const AString &players, int num, int *len) {
+	FILE *f = OpenPlayersFile(players);
+	if (!f) return 0;
+
+	PlayersIndex idx;
+	FILE *x;
+	if (ReadIndexHeader(players, f, &x, &idx)) {
+		int lo = 0;
+		int hi = idx.count - 1;
+		int offset = -1;
+		while (lo <= hi) {
+			int mid = (lo + hi) / 2;
+			char e[PLAYERS_INDEX_ENTRY];
+			if (fseek(x, PLAYERS_INDEX_HEADER + mid * PLAYERS_INDEX_ENTRY,
+					SEEK_SET) ||
+					fread(e, 1, PLAYERS_INDEX_ENTRY, x) != PLAYERS_INDEX_ENTRY)
+				break;
+			int n = GetWord(e);
+			if (n == num) {
+				offset = GetWord(e + 4);
+				*len = GetWord(e + 8);
+				break;
+			}
+			if (n < num) lo = mid + 1;
+			else hi = mid - 1;
+		}
+		fclose(x);
+		if (lo > hi) {
+			fclose(f);
+			return 0;
+		}
+
+		if (offset >= 0 && *len > 0 && offset + *len <= idx.size &&
+				!fseek(f, offset, SEEK_SET)) {
+			char *buf = new char[*len + 1];
+			int got = fread(buf, 1, *len, f);
+			buf[got] = '\0';
+			AString value;
+			int n;
+			NextLine(buf, buf + got, &n);
+			if (got == *len && LineKey(buf, n, "Faction:", &value) &&
+					value.value() == num) {
+				fclose(f);
+				return buf;
+			}
+			delete [] buf;
+		}
+	}
+
+	int size;
+	char *all = ReadPlayersFile(f, &size, &idx);
+	fclose(f);
+	if (!all) return 0;
+	ScanPlayers(all, size, &idx);
+	int *e = FindEntry(&idx, num);
+	char *buf = 0;
+	if (e) {
+		*len = e[2];
+		buf = new char[*len + 1];
+		memcpy(buf, all + e[1], *len);
+		buf[*len] = '\0';
+	}
+	delete [] idx.entries;
+	delete [] all;
+	return buf;
+}
+
+//
+// Print each value of key in the lines, with prefix in front; returns the
+// number printed.
+//
+static int PrintValues(const char *s, int len, const AString &key,
+		const AString &prefix) {
+	const char *end = s + len;
+	int found = 0;
+	while (s < end) {
+		int n;
+		const char *next = NextLine(s, end, &n);
+		AString value;
+		if (LineKey(s, n, key, &value)) {
+			AString line = prefix;
+			line += value;
+			Awrite(line);
+			found++;
+		}
+		s = next;
+	}
+	return found;
+}
+
+//
+// Write the players file under a temporary name, with the mode and owner
+// of the old one, and move it over the old one, so a reader sees either
+// the old file or the new one and never part of either.  The new file is
+// locked before it is moved into place, and *lock holds that lock, so
+// the index can be written for it before the next set starts.
+//
+static int ReplacePlayersFile(const AString &players, const char *head,
+		int headlen, const AString &line, const char *tail, int taillen,
+		int *lock) {
+	*lock = -1;
+	AString name = players;
+	AString temp = players;
+	temp += ".tmp";
+	FILE *f = fopen(temp.Str(), "wb");
+	if (!f) return 0;
+	int ok = (fwrite(head, 1, headlen, f) == (size_t) headlen);
+	AString l = line;
+	if (ok) ok = (fwrite(l.Str(), 1, l.Len(), f) == (size_t) l.Len());
+	if (ok) ok = (fwrite(tail, 1, taillen, f) == (size_t) taillen);
+	if (ok) ok = !fflush(f);
+#ifndef WIN32
+	struct stat st;
+	if (ok) ok = !stat(name.Str(), &st);
+	if (ok) ok = !fchmod(fileno(f), st.st_mode & 07777);
+	if (ok && (st.st_uid != geteuid() || st.st_gid != getegid()))
+		ok = !fchown(fileno(f), st.st_uid, st.st_gid);
+	if (ok) ok = !fsync(fileno(f));
+	if (ok) ok = ((*lock = dup(fileno(f))) != -1);
+	if (ok) ok = !flock(*lock, LOCK_EX);
+#endif
+	if (fclose(f)) ok = 0;
+#ifdef WIN32
+	if (ok) remove(name.Str());
+#endif
+	if (ok) ok = !rename(temp.Str(), name.Str());
+	if (!ok) {
+		remove(temp.Str());
+#ifndef WIN32
+		if (*lock != -1) close(*lock);
+#endif
+		*lock = -1;
+	}
+	return ok;
+}
+
+//
+// Set key in the lines of faction num, replacing the first line with
+// that key or adding one at the end of the faction, and replace the file,
+// then the index.
+//
+static int SetFactionLocked(const AString &players, int num,
+		const AString &key, const AString &value) {
+	FILE *f = OpenPlayersFile(players);
+	int len;
+	PlayersIndex idx;
+	char *buf = f ? ReadPlayersFile(f, &len, &idx) : 0;
+	if (f) fclose(f);
+	if (!buf) {
+		Awrite(AString("Couldn't open ") + players);
+		return 0;
+	}
+	ScanPlayers(buf, len, &idx);
+	int *e = FindEntry(&idx, num);
+	if (!e) {
+		Awrite(AString("No faction ") + num + " in " + players);
+		delete [] idx.entries;
+		delete [] buf;
+		return 0;
+	}
+
+	const char *end = buf + e[1] + e[2];
+	const char *from = end;
+	const char *to = end;
+	const char *s = buf + e[1];
+	while (s < end) {
+		int n;
+		const char *next = NextLine(s, end, &n);
+		if (LineKey(s, n, key, 0)) {
+			from = s;
+			to = s + n;
+			break;
+		}
+		s = next;
+	}
+	delete [] idx.entries;
+
+	AString line = key;
+	line += " ";
+	line += value;
+	if (from == end) {
+		line += "\n";
+		if (end > buf && end[-1] != '\n') line = AString("\n") + line;
+	}
+
+	int lock;
+	int ok = ReplacePlayersFile(players, buf, from - buf, line, to,
+			buf + len - to, &lock);
+	delete [] buf;
+	if (!ok) {
+		Awrite(AString("Couldn't write ") + players);
+		return 0;
+	}
+
+	ok = WriteIndexLocked(players);
+#ifndef WIN32
+	close(lock);
+#endif
+	if (!ok) {
+		Awrite(AString("Couldn't write the index for ") + players);
+		return 0;
+	}
+	return 1;
+}
+
+//
+// SetFactionLocked, holding the players file lock for the whole read,
+// change and write.
+//
+static int SetFactionValue(const AString &players, int num, const AString &key,
+		const AString &value) {
+#ifndef WIN32
+	int lock = LockPlayersFile(players);
+	if (lock == -1) {
+		Awrite(AString("Couldn't lock ") + players);
+		return 0;
+	}
+#endif
+	int ok = SetFactionLocked(players, num, key, value);
+#ifndef WIN32
+	close(lock);
+#endif
+	return ok;
+}
+
+static void PlayersUsage() {
+	Awrite("atlantis players [--file <players>] get <faction> <field>");
+	Awrite("atlantis players [--file <players>] set <faction> <field> "
+			"<value>");
+	Awrite("atlantis players [--file <players>] list [<field>]");
+	Awrite("atlantis players [--file <players>] turn|newunit|active|index");
+}
+
+//
+// A field is named as it is in the file, with or without the colon.
+//
+static AString FieldKey(const char *field) {
+	AString key = field;
+	int n = strlen(field);
+	if (!n || field[n - 1] != ':') key += ":";
+	return key;
+}
+
+int PlayersCommand(int argc, char *argv[]) {
+	AString players = "players.in";
+	if (argc >= 2 && AString(argv[0]) == "--file") {
+		players = argv[1];
+		argc -= 2;
+		argv += 2;
+	}
+	if (argc < 1) {
+		PlayersUsage();
+		return 0;
+	}
+
+	AString command = argv[0];
+	if (command == "index" && argc == 1) {
+		if (!WritePlayersIndex(players)) {
+			Awrite(AString("Couldn't write the index for ") + players);
+			return 0;
+		}
+		return 1;
+	}
+
+	if (command == "get" && argc == 3) {
+		int len;
+		char *buf = GetFactionLines(players, atoi(argv[1]), &len);
+		if (!buf) return 0;
+		int found = PrintValues(buf, len, FieldKey(argv[2]), "");
+		delete [] buf;
+		return found > 0;
+	}
+
+	if (command == "set" && argc >= 4) {
+		AString key = FieldKey(argv[2]);
+		if (key == "Faction:") {
+			Awrite("A faction's number can't be changed.");
+			return 0;
+		}
+		AString value = argv[3];
+		for (int i = 4; i < argc; i++) value = value + " " + argv[i];
+		return SetFactionValue(players, atoi(argv[1]), key, value);
+	}
+
+	if ((command == "turn" || command == "newunit" || command == "active") &&
+			argc == 1) {
+		FILE *f = OpenPlayersFile(players);
+		if (!f) {
+			Awrite(AString("Couldn't open ") + players);
+			return 0;
+		}
+		PlayersIndex idx;
+		FILE *x;
+		if (ReadIndexHeader(players, f, &x, &idx)) {
+			fclose(x);
+		} else {
+			int len;
+			char *buf = ReadPlayersFile(f, &len, &idx);
+			if (!buf) {
+				fclose(f);
+				Awrite(AString("Couldn't read ") + players);
+				return 0;
+			}
+			ScanPlayers(buf, len, &idx);
+			delete [] idx.entries;
+			delete [] buf;
+		}
+		fclose(f);
+		if (command == "turn") Awrite(AString(idx.turn));
+		else if (command == "newunit") Awrite(AString(idx.newunit));
+		else Awrite(AString(idx.active));
+		return 1;
+	}
+
+	if (command == "list" && argc <= 2) {
+		FILE *f = OpenPlayersFile(players);
+		if (!f) {
+			Awrite(AString("Couldn't open ") + players);
+			return 0;
+		}
+		//
+		// Listing only the numbers needs just the index; listing a field
+		// needs the whole file either way.
+		//
+		int len = 0;
+		char *buf = 0;
+		PlayersIndex idx;
+		int indexed = 0;
+		if (argc == 1) indexed = ReadIndex(players, f, &idx);
+		if (!indexed) buf = ReadPlayersFile(f, &len, &idx);
+		if (buf && argc == 2) indexed = ReadIndex(players, f, &idx);
+		fclose(f);
+		if (!indexed && !buf) {
+			Awrite(AString("Couldn't read ") + players);
+			return 0;
+		}
+		if (!indexed) ScanPlayers(buf, len, &idx);
+		for (int i = 0; i < idx.count; i++) {
+			int *e = idx.entries + 3 * i;
+			if (argc == 1) Awrite(AString(e[0]));
+			else if (e[1] >= 0 && e[2] >= 0 && e[1] + e[2] <= len)
+				PrintValues(buf + e[1], e[2], FieldKey(argv[1]),
+						AString(e[0]) + " ");
+		}
+		delete [] idx.entries;
+		delete [] buf;
+		return 1;
+	}
+
+	PlayersUsage();
+	return 0;
+}
@@ -0,0 +1,64 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#ifndef PLAYER_INDEX
+#define PLAYER_INDEX
+
+#include "astring.h"
+
+//
+// The players index is a small binary file kept next to the players
+// file, under the same name with ".idx" added, so that scripts can look
+// up one faction without working through all of players.in.  It starts
+// with a header of twelve 4 byte little endian words:
+//
+//   magic, version, size of the players file, turn number,
+//   next free NewUnit number, factions with orders this turn, factions,
+//   inode of the players file (low and high words), modification time
+//   of the players file (seconds, low and high words, then nanoseconds)
+//
+// followed by one entry of three words for each faction, in order of
+// faction number: the number, and the offset and length of its lines in
+// the players file.  A reader only uses the index if the size, inode and
+// time all match the players file it has open; otherwise it works the
+// index out from the players file itself.
+//
+#define PLAYERS_INDEX_MAGIC "\211API"
+#define PLAYERS_INDEX_VERSION 3
+#define PLAYERS_INDEX_HEADER 48
+#define PLAYERS_INDEX_ENTRY 12
+
+//
+// Write the index for the named players file, holding the lock that
+// players set takes.  Returns 0 on failure.
+//
+int WritePlayersIndex(const AString &);
+
+//
+// atlantis players [--file <players>] <command> ...; argv starts at the
+// command.  Returns 0 if the command failed.
+//
+int PlayersCommand(int argc, char *argv[]);
+
+#endif
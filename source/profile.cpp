@@ -0,0 +1,202 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#include "profile.h"
+#include "fileio.h"
+#include "gameio.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+double Aclock() {
+#ifdef WIN32
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double) now.QuadPart / (double) freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+	struct timeval tv;
+	gettimeofday(&tv, 0);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+#endif
+}
+
+TurnProfile::TurnProfile() {
+	current = 0;
+	started = 0;
+	turn = 0;
+	runs = 1;
+	threads = 1;
+	regions = 0;
+	factions = 0;
+	units = 0;
+	battles = 0;
+}
+
+void TurnProfile::Phase(const char *name) {
+	double now = Aclock();
+	if (current) current->seconds += now - started;
+	current = 0;
+	if (!name) return;
+
+	current = new PhaseTime;
+	current->name = name;
+	current->seconds = 0;
+	phases.Add(current);
+	started = Aclock();
+}
+
+void TurnProfile::Clear() {
+	phases.DeleteAll();
+	current = 0;
+}
+
+void TurnProfile::Copy(TurnProfile *from) {
+	Clear();
+	turn = from->turn;
+	runs = from->runs;
+	threads = from->threads;
+	regions = from->regions;
+	factions = from->factions;
+	units = from->units;
+	battles = from->battles;
+	forlist(&from->phases) {
+		PhaseTime *p = new PhaseTime;
+		p->name = ((PhaseTime *) elem)->name;
+		p->seconds = ((PhaseTime *) elem)->seconds;
+		phases.Add(p);
+	}
+}
+
+static int CompareSeconds(const void *a, const void *b) {
+	double x = *(const double *) a;
+	double y = *(const double *) b;
+	return (x > y) - (x < y);
+}
+
+void TurnProfile::Median(TurnProfile **list, int n) {
+	Clear();
+	if (n < 1) return;
+
+	TurnProfile *first = list[0];
+	turn = first->turn;
+	runs = n;
+	threads = first->threads;
+	regions = first->regions;
+	factions = first->factions;
+	units = first->units;
+	battles = first->battles;
+
+	//
+	// Every run of a turn goes through the same phases in the same
+	// order, so the phases line up by position.
+	//
+	double *times = new double[n];
+	AListElem **at = new AListElem *[n];
+	for (int i = 0; i < n; i++) at[i] = list[i]->phases.First();
+	while (at[0]) {
+		PhaseTime *p = new PhaseTime;
+		p->name = ((PhaseTime *) at[0])->name;
+		for (int i = 0; i < n; i++) {
+			times[i] = at[i] ? ((PhaseTime *) at[i])->seconds : 0;
+			if (at[i]) at[i] = list[i]->phases.Next(at[i]);
+		}
+		qsort(times, n, sizeof(double), CompareSeconds);
+		p->seconds = (n % 2) ? times[n / 2] :
+			(times[n / 2 - 1] + times[n / 2]) / 2;
+		phases.Add(p);
+	}
+	delete [] at;
+	delete [] times;
+}
+
+double TurnProfile::Total() {
+	double total = 0;
+	forlist(&phases) total += ((PhaseTime *) elem)->seconds;
+	return total;
+}
+
+void TurnProfile::Print() {
+	char buf[128];
+	double total = Total();
+
+	Awrite(runs > 1 ? AString("Median phase times over ") + runs + " runs:" :
+			AString("Phase times:"));
+	forlist(&phases) {
+		PhaseTime *p = (PhaseTime *) elem;
+		sprintf(buf, "  %-28s %9.3fs %5.1f%%", p->name.Str(), p->seconds,
+				total > 0 ? p->seconds * 100 / total : 0.0);
+		Awrite(buf);
+	}
+	sprintf(buf, "  %-28s %9.3fs", "Total", total);
+	Awrite(buf);
+	Awrite(AString("  Regions: ") + regions + ", factions: " + factions +
+			", units: " + units + ", battles: " + battles);
+}
+
+//
+// Write the profile out as JSON, one phase per line so the file also
+// diffs and greps well.
+//
+int TurnProfile::Write(const AString &filename) {
+	Aoutfile f;
+	if (f.OpenByName(filename) == -1) return 0;
+
+	char buf[256];
+	f.PutStr(AString("{"));
+	sprintf(buf, "  \"turn\": %d,", turn);
+	f.PutStr(buf);
+	sprintf(buf, "  \"runs\": %d,", runs);
+	f.PutStr(buf);
+	sprintf(buf, "  \"threads\": %d,", threads);
+	f.PutStr(buf);
+	sprintf(buf, "  \"counters\": { \"regions\": %d, \"factions\": %d, "
+			"\"units\": %d, \"battles\": %d },", regions, factions, units,
+			battles);
+	f.PutStr(buf);
+	sprintf(buf, "  \"total\": %.6f,", Total());
+	f.PutStr(buf);
+	f.PutStr(AString("  \"phases\": ["));
+	forlist(&phases) {
+		PhaseTime *p = (PhaseTime *) elem;
+		sprintf(buf, "    { \"name\": \"%s\", \"seconds\": %.6f }%s",
+				p->name.Str(), p->seconds, p->next ? "," : "");
+		f.PutStr(buf);
+	}
+	f.PutStr(AString("  ]"));
+	f.PutStr(AString("}"));
+
+	f.Close();
+	return 1;
+}
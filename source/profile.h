@@ -0,0 +1,77 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#ifndef PROFILE_CLASS
+#define PROFILE_CLASS
+
+#include "alist.h"
+#include "astring.h"
+
+/* Seconds on a monotonic clock, for timing turn phases */
+double Aclock();
+
+class PhaseTime : public AListElem {
+	public:
+		AString name;
+		double seconds;
+};
+
+//
+// TurnProfile records how long each phase of a turn takes.  Phase(name)
+// closes the phase that is running, if any, and starts timing the next;
+// Phase(0) just closes it.  The counters say how big the turn was.
+//
+class TurnProfile {
+	public:
+		TurnProfile();
+
+		void Phase(const char *);
+		void Clear();
+		void Copy(TurnProfile *);
+
+		//
+		// Set this profile to the per-phase median of a number of runs
+		// of the same turn.
+		//
+		void Median(TurnProfile **, int runs);
+
+		double Total();
+		void Print();
+		int Write(const AString &);
+
+		AList phases;
+		int turn;
+		int runs;
+		int threads;
+		int regions;
+		int factions;
+		int units;
+		int battles;
+
+	private:
+		PhaseTime *current;
+		double started;
+};
+
+#endif
@@ -29,71 +29,101 @@ void Game::RunOrders() {
 	//
 	// Form and instant orders are handled during parsing
 	//
+	profile.Phase("RunFindOrders");
 	Awrite("Running FIND Orders...");
 	RunFindOrders();
+	profile.Phase("DoAttackOrders");
 	Awrite("Running Combat...");
 	DoAttackOrders();
+	profile.Phase("DoAutoAttacks");
 	DoAutoAttacks();
+	profile.Phase("RunStealOrders");
 	Awrite("Running STEAL/ASSASSINATE Orders...");
 	RunStealOrders();
+	profile.Phase("DoGiveOrders");
 	Awrite("Running GIVE/PAY/TRANSFER Orders...");
 	DoGiveOrders();
+	profile.Phase("DoExchangeOrders");
 	Awrite("Running EXCHANGE Orders...");
 	DoExchangeOrders();
+	profile.Phase("RunDestroyOrders");
 	Awrite("Running DESTROY Orders...");
 	RunDestroyOrders();
+	profile.Phase("RunEnterOrders");
 	Awrite("Running ENTER/LEAVE Orders...");
 	RunEnterOrders();
+	profile.Phase("RunPromoteOrders");
 	Awrite("Running PROMOTE/EVICT Orders...");
 	RunPromoteOrders();
+	profile.Phase("RunPillageOrders");
 	Awrite("Running PILLAGE Orders...");
 	RunPillageOrders();
+	profile.Phase("RunTaxOrders");
 	Awrite("Running TAX Orders...");
 	RunTaxOrders();
+	profile.Phase("DoGuard1Orders");
 	Awrite("Running GUARD 1 Orders...");
 	DoGuard1Orders();
+	profile.Phase("RunCastOrders");
 	Awrite("Running Magic Orders...");
 	ClearCastEffects();
 	RunCastOrders();
+	profile.Phase("RunSellOrders");
 	Awrite("Running SELL Orders...");
 	RunSellOrders();
+	profile.Phase("RunBuyOrders");
 	Awrite("Running BUY Orders...");
 	RunBuyOrders();
+	profile.Phase("RunForgetOrders");
 	Awrite("Running FORGET Orders...");
 	RunForgetOrders();
+	profile.Phase("MidProcessTurn");
 	Awrite("Mid-Turn Processing...");
 	MidProcessTurn();
+	profile.Phase("RunQuitOrders");
 	Awrite("Running QUIT Orders...");
 	RunQuitOrders();
+	profile.Phase("DeleteEmptyUnits");
 	Awrite("Removing Empty Units...");
 	DeleteEmptyUnits();
 	SinkUncrewedShips();
 	DrownUnits();
 	if (Globals->ALLOW_WITHDRAW) {
+		profile.Phase("DoWithdrawOrders");
 		Awrite("Running WITHDRAW Orders...");
 		DoWithdrawOrders();
 	}
+	profile.Phase("RunSailOrders");
 	Awrite("Running Sail Orders...");
 	RunSailOrders();
+	profile.Phase("RunMoveOrders");
 	Awrite("Running Move Orders...");
 	RunMoveOrders();
+	profile.Phase("RunTunnelOrders");
 	Awrite("Running Tunnel Orders...");
 	RunTunnelOrders();
 	SinkUncrewedShips();
 	DrownUnits();
 	FindDeadFactions();
+	profile.Phase("RunTeachOrders");
 	Awrite("Running Teach Orders...");
 	RunTeachOrders();
+	profile.Phase("RunMonthOrders");
 	Awrite("Running Month-long Orders...");
 	RunMonthOrders();
+	profile.Phase("RunTeleportOrders");
 	RunTeleportOrders();
+	profile.Phase("AssessMaintenance");
 	Awrite("Assessing Maintenance costs...");
 	AssessMaintenance();
+	profile.Phase("PostProcessTurn");
 	Awrite("Post-Turn Processing...");
 	PostProcessTurn();
+	profile.Phase("RemoveEmptyObjects");
 	DeleteEmptyUnits();
 	EmptyHell();
 	RemoveEmptyObjects();
+	profile.Phase(0);
 }
 
 void Game::ClearCastEffects() {
@@ -599,7 +629,7 @@ void Game::Do1Quit(Faction * f) {
 			forlist(&o->units) {
 				Unit * u = (Unit *) elem;
 				if (u->faction == f) {
-					o->units.Remove(u);
+					u->MoveUnit(0);
 					delete u;
 				}
 			}
@@ -1079,10 +1109,29 @@ void Game::MidProcessTurn() {
 	}
 }
 
+void Game::PostTurnRegion(ARegion * r) {
+	r->PostTurn(&regions);
+}
+
 void Game::PostProcessTurn() {
+	FactionLog *logs = 0;
+	RandomStream *stream = 0;
+	if (ParallelRegions())
+		logs = RunRegionPhase(&Game::PostTurnRegion, RSTREAM_POSTTURN);
+	else if (Globals->REGION_RANDOM_STREAMS)
+		stream = newrandomstream();
+
+	int i = 0;
 	forlist(&regions) {
 		ARegion * r = (ARegion *) elem;
-		r->PostTurn(&regions);
+		if (logs) {
+			logs[i++].Replay();
+		} else {
+			RandomStream *old = 0;
+			if (stream) old = UseRegionStream(stream, r, RSTREAM_POSTTURN);
+			PostTurnRegion(r);
+			if (stream) userandomstream(old);
+		}
 
 		if (Globals->CITY_MONSTERS_EXIST && (r->town || r->type == R_NEXUS))
 			AdjustCityMons(r);
@@ -1096,6 +1145,9 @@ void Game::PostProcessTurn() {
 		}
 	}
 
+	delete [] logs;
+	if (stream) deleterandomstream(stream);
+
 	if (Globals->WANDERING_MONSTERS_EXIST) GrowWMons(Globals->WMON_FREQUENCY);
 
 	if (Globals->LAIR_MONSTERS_EXIST) GrowLMons(Globals->LAIR_FREQUENCY);
@@ -1150,17 +1202,17 @@ void Game::DoAdvanceAttacks(AList * locs) {
 		if (u->IsAlive() && u->canattack) {
 			DoAutoAttack(r,u);
 			if (!u->IsAlive() || !u->canattack) {
-				u->guard = GUARD_NONE;
+				u->SetGuard(GUARD_NONE);
 			}
 		}
 		if (u->IsAlive() && u->canattack && u->guard == GUARD_ADVANCE) {
 			DoAdvanceAttack(r,u);
-			u->guard = GUARD_NONE;
+			u->SetGuard(GUARD_NONE);
 		}
 		if (u->IsAlive()) {
 			DoAutoAttackOn(r,u);
 			if (!u->IsAlive() || !u->canattack) {
-				u->guard = GUARD_NONE;
+				u->SetGuard(GUARD_NONE);
 			}
 		}
 		}
@@ -1329,8 +1381,8 @@ void Game::DoAttackOrders() {
 								AttemptAttack( r, u, targets, 0 );
 							else
 								u->Error(AString("ATTACK: Non-existent unit."));
-							delete ord;
 							u->attackorders.Remove(ord);
+							delete ord;
 							targets.DeleteAll();
 						}
 					}
@@ -1382,13 +1434,32 @@ void Game::AttemptAttack(ARegion * r,Unit * u,AList & targets,int silent,int adv
 		RunBattle( r, u, &targets, 0, adv );
 }
 
+void Game::RunSellRegion(ARegion * r) {
+	forlist((&r->markets)) {
+		Market * m = (Market *) elem;
+		if (m->type == M_SELL)
+			DoSell(r,m);
+	}
+}
+
 void Game::RunSellOrders() {
+	FactionLog *logs = 0;
+	RandomStream *stream = 0;
+	if (ParallelRegions())
+		logs = RunRegionPhase(&Game::RunSellRegion, RSTREAM_SELL);
+	else if (Globals->REGION_RANDOM_STREAMS)
+		stream = newrandomstream();
+
+	int i = 0;
 	forlist((&regions)) {
 		ARegion * r = (ARegion *) elem;
-		forlist((&r->markets)) {
-			Market * m = (Market *) elem;
-			if (m->type == M_SELL)
-				DoSell(r,m);
+		if (logs) {
+			logs[i++].Replay();
+		} else {
+			RandomStream *old = 0;
+			if (stream) old = UseRegionStream(stream, r, RSTREAM_SELL);
+			RunSellRegion(r);
+			if (stream) userandomstream(old);
 		}
 		{
 			forlist((&r->objects)) {
@@ -1403,6 +1474,9 @@ void Game::RunSellOrders() {
 			}
 		}
 	}
+
+	delete [] logs;
+	if (stream) deleterandomstream(stream);
 }
 
 int Game::GetSellAmount(ARegion * r,Market * m) {
@@ -1468,13 +1542,32 @@ void Game::DoSell(ARegion * r,Market * m) {
 	m->amount = oldamount;
 }
 
+void Game::RunBuyRegion(ARegion * r) {
+	forlist((&r->markets)) {
+		Market * m = (Market *) elem;
+		if (m->type == M_BUY)
+			DoBuy(r,m);
+	}
+}
+
 void Game::RunBuyOrders() {
+	FactionLog *logs = 0;
+	RandomStream *stream = 0;
+	if (ParallelRegions())
+		logs = RunRegionPhase(&Game::RunBuyRegion, RSTREAM_BUY);
+	else if (Globals->REGION_RANDOM_STREAMS)
+		stream = newrandomstream();
+
+	int i = 0;
 	forlist((&regions)) {
 		ARegion * r = (ARegion *) elem;
-		forlist((&r->markets)) {
-			Market * m = (Market *) elem;
-			if (m->type == M_BUY)
-				DoBuy(r,m);
+		if (logs) {
+			logs[i++].Replay();
+		} else {
+			RandomStream *old = 0;
+			if (stream) old = UseRegionStream(stream, r, RSTREAM_BUY);
+			RunBuyRegion(r);
+			if (stream) userandomstream(old);
 		}
 		{
 			forlist((&r->objects)) {
@@ -1489,6 +1582,9 @@ void Game::RunBuyOrders() {
 			}
 		}
 	}
+
+	delete [] logs;
+	if (stream) deleterandomstream(stream);
 }
 
 int Game::GetBuyAmount(ARegion * r,Market * m) {
@@ -2441,6 +2537,7 @@ int Game::DoGiveOrder(ARegion * r,Unit * u,GiveOrder * o) {
 
 		u->Event(AString("Gives unit to ") + *(t->faction->name) + ".");
 		u->faction = t->faction;
+		InvalidateVision();
 		u->Event("Is given to your faction.");
 
 		if (notallied && u->monthorders && u->monthorders->type == O_MOVE &&
@@ -2540,17 +2637,17 @@ void Game::DoGuard1Orders() {
 				Unit * u = (Unit *) elem;
 				if (u->guard == GUARD_SET || u->guard == GUARD_GUARD) {
 					if (!u->Taxers()) {
-						u->guard = GUARD_NONE;
+						u->SetGuard(GUARD_NONE);
 						u->Error("Must be combat ready to be on guard.");
 						continue;
 					}
 					if (u->type != U_GUARD && r->HasCityGuard()) {
-						u->guard = GUARD_NONE;
+						u->SetGuard(GUARD_NONE);
 						u->Error("Is prevented from guarding by the "
 								"Guardsmen.");
 						continue;
 					}
-					u->guard = GUARD_GUARD;
+					u->SetGuard(GUARD_GUARD);
 				}
 			}
 		}
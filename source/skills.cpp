@@ -24,17 +24,22 @@
 // END A3HEADER
 #include "skills.h"
 #include "items.h"
+#include "aregion.h"
 #include <gamedata.h>
 
-int ParseSkill(AString * token) {
-	int r = -1;
+static NameIndex skillindex;
+
+void IndexSkillNames() {
+	skillindex.Clear();
 	for (int i=0; i<NSKILLS; i++) {
-		if ((*token == SkillDefs[i].name) ||
-			(*token == SkillDefs[i].abbr)) {
-		   	r = i;
-			break;
-		}
+		skillindex.Add(SkillDefs[i].name, i);
+		skillindex.Add(SkillDefs[i].abbr, i);
 	}
+}
+
+int ParseSkill(AString * token) {
+	if (!skillindex.Num()) IndexSkillNames();
+	int r = skillindex.Find(token->Str());
 	if (r != -1) {
 		if (SkillDefs[r].flags & SkillType::DISABLED) r = -1;
 	}
@@ -118,38 +123,87 @@ Skill * Skill::Split(int total, int leave) {
 	return temp;
 }
 
-int SkillList::GetDays(int skill) {
-	forlist(this) {
-		Skill * s = (Skill *) elem;
-		if (s->type == skill) {
-			return s->days;
+SkillList::SkillList() {
+	unitlist = 0;
+	dups = 0;
+}
+
+void SkillList::Add(AListElem * e) {
+	AList::Add(e);
+	if (!index.Insert(((Skill *) e)->type, e)) dups = 1;
+}
+
+void SkillList::Insert(AListElem * e) {
+	AList::Insert(e);
+	Skill *s = (Skill *) e;
+	if (!index.Insert(s->type, s)) {
+		// The new first entry for this skill is the one lookups see
+		index.Erase(s->type);
+		index.Insert(s->type, s);
+		dups = 1;
+	}
+}
+
+char SkillList::Remove(AListElem * e) {
+	if (!AList::Remove(e)) return 0;
+	Skill *s = (Skill *) e;
+	if (index.Find(s->type) == s) {
+		index.Erase(s->type);
+		if (dups) {
+			forlist(this) {
+				if (((Skill *) elem)->type == s->type) {
+					index.Insert(s->type, elem);
+					break;
+				}
+			}
 		}
 	}
+	return 1;
+}
+
+void SkillList::DeleteAll() {
+	AList::DeleteAll();
+	index.Clear();
+	dups = 0;
+}
+
+void SkillList::Empty() {
+	AList::Empty();
+	index.Clear();
+	dups = 0;
+}
+
+Skill * SkillList::Find(int skill) {
+	return (Skill *) index.Find(skill);
+}
+
+int SkillList::GetDays(int skill) {
+	Skill *s = Find(skill);
+	if (s) return s->days;
 	return 0;
 }
 
 void SkillList::SetDays(int skill,int days) {
-	forlist(this) {
-		Skill * s = (Skill *) elem;
-		if (s->type == skill) {
-			if (days == 0) {
-				Remove(s);
-				delete s;
-				return;
-			} else {
-				s->days = days;
-				return;
-			}
+	if (unitlist) InvalidateVision();
+	Skill *s = Find(skill);
+	if (s) {
+		if (days == 0) {
+			Remove(s);
+			delete s;
+		} else {
+			s->days = days;
 		}
+		return;
 	}
 	if (days == 0) return;
-	Skill * s = new Skill;
+	s = new Skill;
 	s->type = skill;
 	s->days = days;
 	Add(s);
 }
 
 SkillList * SkillList::Split(int total,int leave) {
+	if (unitlist) InvalidateVision();
 	SkillList * ret = new SkillList;
 	forlist (this) {
 		Skill * s = (Skill *) elem;
@@ -103,6 +103,7 @@ class SkillType {
 extern SkillType * SkillDefs;
 
 int ParseSkill(AString *);
+void IndexSkillNames();
 AString SkillStrs(int);
 
 class ShowType {
@@ -141,6 +142,8 @@ class Skill : public AListElem {
 
 class SkillList : public AList {
 	public:
+		SkillList();
+
 		int GetDays(int); /* Skill */
 		void SetDays(int,int); /* Skill, days */
 		void Combine(SkillList *);
@@ -148,6 +151,22 @@ class SkillList : public AList {
 		AString Report(int); /* Number of men */
 		void Readin(Ainfile *);
 		void Writeout(Aoutfile *);
+
+		/* These keep the type index in step with the list */
+		void Add(AListElem *);
+		void Insert(AListElem *);
+		char Remove(AListElem *);
+		void DeleteAll();
+		void Empty();
+
+		/* Set for a unit's skills; changes then call InvalidateVision() */
+		int unitlist;
+
+	private:
+		Skill * Find(int);
+
+		AListIndex index;
+		int dups; /* Read in with more than one entry for a skill */
 };
 
 class HealType {
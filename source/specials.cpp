@@ -64,41 +64,42 @@ int Army::CheckSpecialTarget(int special,int tar) {
 	SpecialType *spd = &SpecialDefs[special];
 	int i;
 	int match = 0;
+	int t = soldiers[tar];
 
 	if (spd->targflags & SpecialType::HIT_BUILDINGIF) {
 		match = 0;
-		if (!soldiers[tar]->building) return 0;
+		if (!pool[t].building) return 0;
 		for(i = 0; i < 3; i++) {
-			if (soldiers[tar]->building &&
-					(spd->buildings[i] == soldiers[tar]->building)) match = 1;
+			if (pool[t].building &&
+					(spd->buildings[i] == pool[t].building)) match = 1;
 		}
 		if (!match) return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_BUILDINGEXCEPT) {
 		match = 0;
-		if (!soldiers[tar]->building) return 0;
+		if (!pool[t].building) return 0;
 		for(i = 0; i < 3; i++) {
-			if (soldiers[tar]->building &&
-					(spd->buildings[i] == soldiers[tar]->building)) match = 1;
+			if (pool[t].building &&
+					(spd->buildings[i] == pool[t].building)) match = 1;
 		}
 		if (match) return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_SOLDIERIF) {
 		match = 0;
-		if (soldiers[tar]->race == -1) return 0;
+		if (pool[t].race == -1) return 0;
 		for(i = 0; i < 7; i++) {
-			if (soldiers[tar]->race == spd->targets[i]) match = 1;
+			if (pool[t].race == spd->targets[i]) match = 1;
 		}
 		if (!match) return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_SOLDIEREXCEPT) {
 		match = 0;
-		if (soldiers[tar]->race == -1) return 0;
+		if (pool[t].race == -1) return 0;
 		for(i = 0; i < 7; i++) {
-			if (soldiers[tar]->race == spd->targets[i]) match = 1;
+			if (pool[t].race == spd->targets[i]) match = 1;
 		}
 		if (match) return 0;
 	}
@@ -106,7 +107,7 @@ int Army::CheckSpecialTarget(int special,int tar) {
 	if (spd->targflags & SpecialType::HIT_EFFECTIF) {
 		match = 0;
 		for(i = 0; i < 3; i++) {
-			if (soldiers[tar]->HasEffect(spd->effects[i])) match = 1;
+			if (HasEffect(t, spd->effects[i])) match = 1;
 		}
 		if (!match) return 0;
 	}
@@ -114,25 +115,25 @@ int Army::CheckSpecialTarget(int special,int tar) {
 	if (spd->targflags & SpecialType::HIT_EFFECTEXCEPT) {
 		match = 0;
 		for(i = 0; i < 3; i++) {
-			if (soldiers[tar]->HasEffect(spd->effects[i])) match = 1;
+			if (HasEffect(t, spd->effects[i])) match = 1;
 		}
 		if (match) return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_MOUNTIF) {
 		match = 0;
-		if (soldiers[tar]->riding == -1) return 0;
+		if (riding[t] == -1) return 0;
 		for(i = 0; i < 7; i++) {
-			if (soldiers[tar]->riding == spd->targets[i]) match = 1;
+			if (riding[t] == spd->targets[i]) match = 1;
 		}
 		if (!match) return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_MOUNTEXCEPT) {
 		match = 0;
-		if (soldiers[tar]->riding == -1) return 0;
+		if (riding[t] == -1) return 0;
 		for(i = 0; i < 7; i++) {
-			if (soldiers[tar]->riding == spd->targets[i]) match = 1;
+			if (riding[t] == spd->targets[i]) match = 1;
 		}
 		if (match) return 0;
 	}
@@ -141,14 +142,14 @@ int Army::CheckSpecialTarget(int special,int tar) {
 		// All illusions are of type monster, so lets make sure we get it
 		// right.  If we ever have other types of illusions, we can change
 		// this.
-		if (!(ItemDefs[soldiers[tar]->race].type & IT_MONSTER))
+		if (!(ItemDefs[pool[t].race].type & IT_MONSTER))
 			return 0;
-		if (ItemDefs[soldiers[tar]->race].index != MONSTER_ILLUSION)
+		if (ItemDefs[pool[t].race].index != MONSTER_ILLUSION)
 			return 0;
 	}
 
 	if (spd->targflags & SpecialType::HIT_NOMONSTER) {
-		if (ItemDefs[soldiers[tar]->race].type & IT_MONSTER)
+		if (ItemDefs[pool[t].race].type & IT_MONSTER)
 			return 0;
 	}
 	return 1;
@@ -158,9 +159,10 @@ void Battle::UpdateShields(Army *a) {
 	for (int i=0; i<a->notbehind; i++) {
 		int shtype = -1;
 		SpecialType *spd;
+		Soldier *s = &a->pool[a->soldiers[i]];
 
-		if (a->soldiers[i]->special == -1) continue;
-		spd = &SpecialDefs[a->soldiers[i]->special];
+		if (s->special == -1) continue;
+		spd = &SpecialDefs[s->special];
 
 		if (!(spd->effectflags & SpecialType::FX_SHIELD) &&
 				!(spd->effectflags & SpecialType::FX_DEFBONUS)) continue;
@@ -170,7 +172,7 @@ void Battle::UpdateShields(Army *a) {
 				if (spd->shield[shtype] == -1) continue;
 				Shield *sh = new Shield;
 				sh->shieldtype = spd->shield[shtype];
-				sh->shieldskill = a->soldiers[i]->slevel;
+				sh->shieldskill = s->slevel;
 				a->shields.Add(sh);
 			}
 		}
@@ -180,12 +182,13 @@ void Battle::UpdateShields(Army *a) {
 				if (spd->defs[shtype].type == -1) continue;
 				int bonus = spd->defs[shtype].val;
 				if (spd->effectflags & SpecialType::FX_USE_LEV)
-					bonus *= a->soldiers[i]->slevel;
-				a->soldiers[i]->dskill[spd->defs[shtype].type] += bonus;
+					bonus *= s->slevel;
+				a->dskill[s->slot * NUM_ATTACK_TYPES +
+					spd->defs[shtype].type] += bonus;
 			}
 		}
 
-		AddLine(*(a->soldiers[i]->unit->name) + " casts " +
+		AddLine(*(s->unit->name) + " casts " +
 				spd->shielddesc + ".");
 	}
 }
@@ -215,7 +218,7 @@ void Battle::DoSpecialAttack(int round, Soldier *a, Army *attackers,
 	// Check for spell failure
 	if( getrandom( 100 ) < a->specialfail ) {
 		if( fullreport ) {
-			AString temp = a->name + " " + spd->spelldesc + ", but the spell fizzles.";
+			AString temp = a->Name() + " " + spd->spelldesc + ", but the spell fizzles.";
 			if( Globals->AGGREGATE_BATTLE_REPORTS ) {
 				attackers->roundLeaderReports.Add( new AString( temp ) );
 			} else {
@@ -255,7 +258,7 @@ void Battle::DoSpecialAttack(int round, Soldier *a, Army *attackers,
 	}
 	if (fullreport) {
 		if (tot == -1) {
-			AString temp = a->name + " " + spd->spelldesc + ", but it is deflected.";
+			AString temp = a->Name() + " " + spd->spelldesc + ", but it is deflected.";
 			if( Globals->AGGREGATE_BATTLE_REPORTS ) {
 				attackers->roundLeaderReports.Add( new AString( temp ) );
 			} else {
@@ -264,7 +267,7 @@ void Battle::DoSpecialAttack(int round, Soldier *a, Army *attackers,
 		} else {
 			AString temp;
 			if (spd->effectflags & SpecialType::FX_DONT_COMBINE) {
-				temp = a->name + " " + spd->spelldesc;
+				temp = a->Name() + " " + spd->spelldesc;
 				for(i = 0; i < dam; i++) {
 					if (i) temp += ", ";
 					if (i == dam-1) temp += " and ";
@@ -272,7 +275,7 @@ void Battle::DoSpecialAttack(int round, Soldier *a, Army *attackers,
 				}
 				temp += AString(spd->spelltarget) + ".";
 			} else {
-				temp =a->name + " " + spd->spelldesc + ", " + spd->spelldesc2 +
+				temp =a->Name() + " " + spd->spelldesc + ", " + spd->spelldesc2 +
 						tot + spd->spelltarget + ".";
 			}
 			if( Globals->AGGREGATE_BATTLE_REPORTS ) {
@@ -25,7 +25,7 @@
 #include "game.h"
 #include <gamedata.h>
 
-void Game::ProcessCastOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
+void Game::ProcessCastOrder(Unit * u,ATokenizer * o, OrdersCheck *pCheck) {
 	int val;
 	AString * token = o->gettoken();
 	if (!token) {
@@ -34,7 +34,6 @@ void Game::ProcessCastOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 
 	int sk = ParseSkill(token);
-	delete token;
 	if (sk==-1) {
 		ParseError(pCheck, u, 0, "CAST: Invalid skill.");
 		return;
@@ -135,14 +134,13 @@ void Game::ProcessCastOrder(Unit * u,AString * o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessItemSpell(Unit *u, AString *o, int skill, OrdersCheck *pCheck) {
+void Game::ProcessItemSpell(Unit *u, ATokenizer *o, int skill, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 	if (!token) {
 		u->Error("CAST: Must specify item.");
 		return;
 	}
 	int item = ParseEnabledItem(token);
-	delete token;
 
 	// handle phantasmal creatures
 	if( skill == S_CREATE_PHANTASMAL_BEASTS ||
@@ -151,10 +149,9 @@ void Game::ProcessItemSpell(Unit *u, AString *o, int skill, OrdersCheck *pCheck)
 	{
 		if( ItemDefs[item].type & IT_MONSTER ) {
 			if( ItemDefs[item].index != MONSTER_ILLUSION ) {
-				token = new AString( "i" );
-				*token += ItemDefs[item].abr;
-				item = ParseEnabledItem(token);
-				delete token;
+				AString mon( "i" );
+				mon += ItemDefs[item].abr;
+				item = ParseEnabledItem(&mon);
 			}
 		}
 	}
@@ -174,7 +171,6 @@ void Game::ProcessItemSpell(Unit *u, AString *o, int skill, OrdersCheck *pCheck)
 
 	if (token) {
 		num = token->value();
-		delete token;
 	}
 	
 	CastItemOrder *order = new CastItemOrder;
@@ -187,7 +183,7 @@ void Game::ProcessItemSpell(Unit *u, AString *o, int skill, OrdersCheck *pCheck)
 	u->castorders = order;
 }
 
-void Game::ProcessMindReading(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessMindReading(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	UnitId *id = ParseUnit(o);
 
 	if (!id) {
@@ -204,7 +200,7 @@ void Game::ProcessMindReading(Unit *u,AString *o, OrdersCheck *pCheck) {
 	u->castorders = order;
 }
 
-void Game::ProcessBirdLore(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessBirdLore(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 
 	if (!token) {
@@ -222,7 +218,6 @@ void Game::ProcessBirdLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if (*token == "direction") {
-		delete token;
 		token = o->gettoken();
 
 		if (!token) {
@@ -231,7 +226,6 @@ void Game::ProcessBirdLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 		}
 
 		int dir = ParseDir(token);
-		delete token;
 		if (dir == -1 || dir > NDIRS) {
 			u->Error("CAST: Invalid direction.");
 			return;
@@ -248,17 +242,15 @@ void Game::ProcessBirdLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	u->Error("CAST: Invalid arguments.");
-	delete token;
 }
 
-void Game::ProcessInvisibility(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessInvisibility(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 
 	if (!token || !(*token == "units")) {
 		u->Error("CAST: Must specify units to render invisible.");
 		return;
 	}
-	delete token;
 
 	CastUnitsOrder *order;
 	if (u->castorders && u->castorders->type == O_CAST &&
@@ -280,7 +272,7 @@ void Game::ProcessInvisibility(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessPhanDemons(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessPhanDemons(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	CastIntOrder *order = new CastIntOrder;
 	order->spell = S_CREATE_PHANTASMAL_DEMONS;
 	order->level = 0;
@@ -303,7 +295,6 @@ void Game::ProcessPhanDemons(Unit *u,AString *o, OrdersCheck *pCheck) {
 	if (*token == "balrog" || *token == "balrogs")
 		order->level = 5;
 
-	delete token;
 
 	if (!order->level) {
 		u->Error("CAST: Can't summon that illusion.");
@@ -317,14 +308,13 @@ void Game::ProcessPhanDemons(Unit *u,AString *o, OrdersCheck *pCheck) {
 		order->target = 1;
 	} else {
 		order->target = token->value();
-		delete token;
 	}
 
 	u->ClearCastOrders();
 	u->castorders = order;
 }
 
-void Game::ProcessPhanUndead(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessPhanUndead(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	CastIntOrder *order = new CastIntOrder;
 	order->spell = S_CREATE_PHANTASMAL_UNDEAD;
 	order->level = 0;
@@ -347,7 +337,6 @@ void Game::ProcessPhanUndead(Unit *u,AString *o, OrdersCheck *pCheck) {
 	if (*token == "lich" || *token == "liches")
 		order->level = 5;
 
-	delete token;
 
 	if (!order->level) {
 		u->Error("CAST: Must specify which illusion to summon.");
@@ -359,7 +348,6 @@ void Game::ProcessPhanUndead(Unit *u,AString *o, OrdersCheck *pCheck) {
 
 	if (token) {
 		order->target = token->value();
-		delete token;
 	} else {
 		order->target = 1;
 	}
@@ -368,7 +356,7 @@ void Game::ProcessPhanUndead(Unit *u,AString *o, OrdersCheck *pCheck) {
 	u->castorders = order;
 }
 
-void Game::ProcessPhanBeasts(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessPhanBeasts(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	CastIntOrder *order = new CastIntOrder;
 	order->spell = S_CREATE_PHANTASMAL_BEASTS;
 	order->level = 0;
@@ -389,7 +377,6 @@ void Game::ProcessPhanBeasts(Unit *u,AString *o, OrdersCheck *pCheck) {
 	if (*token == "dragon" || *token == "dragon")
 		order->level = 5;
 
-	delete token;
 	if (!order->level) {
 		delete order;
 		u->Error("CAST: Must specify which illusion to summon.");
@@ -399,7 +386,6 @@ void Game::ProcessPhanBeasts(Unit *u,AString *o, OrdersCheck *pCheck) {
 	token = o->gettoken();
 	if (token) {
 		order->target = token->value();
-		delete token;
 	}
 
 	u->ClearCastOrders();
@@ -414,7 +400,7 @@ void Game::ProcessGenericSpell(Unit *u,int spell, OrdersCheck *pCheck) {
 	u->castorders = orders;
 }
 
-void Game::ProcessRegionSpell(Unit *u, AString *o, int spell, OrdersCheck *pCheck) {
+void Game::ProcessRegionSpell(Unit *u, ATokenizer *o, int spell, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 	int x = -1;
 	int y = -1;
@@ -425,14 +411,12 @@ void Game::ProcessRegionSpell(Unit *u, AString *o, int spell, OrdersCheck *pChec
 
 	if (token) {
 		if (*token == "region") {
-			delete token;
 			token = o->gettoken();
 			if (!token) {
 				u->Error("CAST: Region X coordinate not specified.");
 				return;
 			}
 			x = token->value();
-			delete token;
 
 			token = o->gettoken();
 			if (!token) {
@@ -440,13 +424,11 @@ void Game::ProcessRegionSpell(Unit *u, AString *o, int spell, OrdersCheck *pChec
 				return;
 			}
 			y = token->value();
-			delete token;
 
 			if (range && (range->flags & RangeType::RNG_CROSS_LEVELS)) {
 				token = o->gettoken();
 				if (token) {
 					z = token->value();
-					delete token;
 					if (z < 0 || (z >= Globals->UNDERWORLD_LEVELS +
 								Globals->UNDERDEEP_LEVELS +
 								Globals->ABYSS_LEVEL + 2)) {
@@ -456,7 +438,6 @@ void Game::ProcessRegionSpell(Unit *u, AString *o, int spell, OrdersCheck *pChec
 				}
 			}
 		} else {
-			delete token;
 		}
 	}
 	if (x == -1) x = u->object->region->xloc;
@@ -482,14 +463,13 @@ void Game::ProcessRegionSpell(Unit *u, AString *o, int spell, OrdersCheck *pChec
 		u->castorders = order;
 }
 
-void Game::ProcessCastPortalLore(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessCastPortalLore(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 	if (!token) {
 		u->Error("CAST: Requires a target mage.");
 		return;
 	}
 	int gate = token->value();
-	delete token;
 	token = o->gettoken();
 
 	if (!token) {
@@ -499,7 +479,6 @@ void Game::ProcessCastPortalLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 
 	if (!(*token == "units")) {
 		u->Error("CAST: No units to teleport.");
-		delete token;
 		return;
 	}
 
@@ -524,7 +503,7 @@ void Game::ProcessCastPortalLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 }
 
-void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
+void Game::ProcessCastGateLore(Unit *u,ATokenizer *o, OrdersCheck *pCheck) {
 	AString *token = o->gettoken();
 
 	if (!token) {
@@ -533,7 +512,6 @@ void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if ((*token) == "gate") {
-		delete token;
 		token = o->gettoken();
 
 		if (!token) {
@@ -556,13 +534,11 @@ void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 		order->spell = S_GATE_LORE;
 		order->level = 3;
 
-		delete token;
 
 		token = o->gettoken();
 
 		if (!token) return;
 		if (!(*token == "units")) {
-			delete token;
 			return;
 		}
 
@@ -590,13 +566,11 @@ void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 		order->spell = S_GATE_LORE;
 		order->level = 1;
 
-		delete token;
 
 		token = o->gettoken();
 
 		if (!token) return;
 		if (!(*token == "units")) {
-			delete token;
 			return;
 		}
 
@@ -609,7 +583,6 @@ void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 	}
 
 	if ((*token) == "detect") {
-		delete token;
 		u->ClearCastOrders();
 		CastOrder *to = new CastOrder;
 		to->spell = S_GATE_LORE;
@@ -618,7 +591,6 @@ void Game::ProcessCastGateLore(Unit *u,AString *o, OrdersCheck *pCheck) {
 		return;
 	}
 
-	delete token;
 	u->Error("CAST: Invalid argument.");
 }
 
@@ -1123,7 +1095,7 @@ void Game::RunConstructGate(ARegion *r,Unit *u, int spell) {
 	u->Event(AString("Constructs a Gate in ")+r->ShortPrint(&regions)+".");
 	u->Practise(S_CONSTRUCT_GATE);
 	regions.numberofgates++;
-	r->gate = regions.numberofgates;
+	regions.SetGate(r, regions.numberofgates);
 	r->NotifySpell(u,S_ARTIFACT_LORE, &regions);
 }
 
@@ -32,21 +32,21 @@
 // Spell parsing - generic
 //
 void ProcessGenericSpell(Unit *, int, OrdersCheck *pCheck);
-void ProcessRegionSpell(Unit *, AString *, int, OrdersCheck *pCheck);
-void ProcessItemSpell(Unit *,AString *, int skill, OrdersCheck *pCheck );
+void ProcessRegionSpell(Unit *, ATokenizer *, int, OrdersCheck *pCheck);
+void ProcessItemSpell(Unit *,ATokenizer *, int skill, OrdersCheck *pCheck );
 
 //
 // Spell parsing - specific
 //
-void ProcessCastGateLore(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessCastPortalLore(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessPhanBeasts(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessPhanUndead(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessPhanDemons(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessInvisibility(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessBirdLore(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessMindReading(Unit *,AString *, OrdersCheck *pCheck );
-void ProcessLacandonTeleport(Unit *, AString *, OrdersCheck *pCheck);
+void ProcessCastGateLore(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessCastPortalLore(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessPhanBeasts(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessPhanUndead(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessPhanDemons(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessInvisibility(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessBirdLore(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessMindReading(Unit *,ATokenizer *, OrdersCheck *pCheck );
+void ProcessLacandonTeleport(Unit *, ATokenizer *, OrdersCheck *pCheck);
 
 //
 // Spell helpers
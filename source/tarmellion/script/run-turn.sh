@@ -54,6 +54,7 @@ if [ $? -eq 0 ]; then
 	    
 		mv game.out game.in
 		mv players.out players.in
+		mv players.out.idx players.in.idx
 		chgrp www-data players.in
 		chmod 664 players.in
 
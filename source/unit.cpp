@@ -53,6 +53,31 @@ UnitPtr *GetUnitList(AList *list, Unit *u) {
 	return 0;
 }
 
+static Unit **liveunits = 0;
+static int maxliveunits = 0;
+
+static void SetLiveUnit(int num, Unit *u) {
+	if (num < 0) return;
+	if (num >= maxliveunits) {
+		if (!u) return;
+		int newmax = maxliveunits + 10000;
+		while (newmax <= num) newmax += 10000;
+		Unit **temp = new Unit *[newmax];
+		int i;
+		for (i = 0; i < maxliveunits; i++) temp[i] = liveunits[i];
+		for (; i < newmax; i++) temp[i] = 0;
+		if (liveunits) delete [] liveunits;
+		liveunits = temp;
+		maxliveunits = newmax;
+	}
+	liveunits[num] = u;
+}
+
+Unit *GetLiveUnit(int num) {
+	if (num < 0 || num >= maxliveunits) return 0;
+	return liveunits[num];
+}
+
 Unit::Unit() {
 	name = 0;
 	describe = 0;
@@ -71,6 +96,8 @@ Unit::Unit() {
 	}
 	readyItem = -1;
 	object = 0;
+	items.unitlist = 1;
+	skills.unitlist = 1;
 	evictorders = NULL;
 	stealorders = NULL;
 	monthorders = NULL;
@@ -104,6 +131,8 @@ Unit::Unit(int seq, Faction * f, int a) {
 	}
 	readyItem = -1;
 	object = 0;
+	items.unitlist = 1;
+	skills.unitlist = 1;
 	evictorders = NULL;
 	stealorders = NULL;
 	monthorders = NULL;
@@ -118,6 +147,7 @@ Unit::Unit(int seq, Faction * f, int a) {
 }
 
 Unit::~Unit() {
+	if (GetLiveUnit(num) == this) SetLiveUnit(num, 0);
 	if (monthorders) delete monthorders;
 	if (presentMonthOrders) delete presentMonthOrders;
 	if (stealorders) delete stealorders;
@@ -126,7 +156,7 @@ Unit::~Unit() {
 }
 
 void Unit::SetMonFlags() {
-	guard = GUARD_AVOID;
+	SetGuard(GUARD_AVOID);
 	SetFlag(FLAG_HOLDING,1);
 }
 
@@ -166,11 +196,7 @@ void Unit::Writeout(Aoutfile *s) {
 
 void Unit::Readin(Ainfile *s, AList *facs, ATL_VER v) {
 	name = s->GetStr();
-	describe = s->GetStr();
-	if (*describe == "none") {
-		delete describe;
-		describe = 0;
-	}
+	describe = s->GetStrOrNone();
 	num = s->GetInt();
 	type = s->GetInt();
 	int i = s->GetInt();
@@ -619,7 +645,7 @@ void Unit::DefaultOrders(Object * obj) {
 		}
 	} else if (type == U_GUARD) {
 		if (guard != GUARD_GUARD)
-			guard = GUARD_SET;
+			SetGuard(GUARD_SET);
 	} else if (type == U_GUARDMAGE) {
 		combat = S_FIRE;
 	} else{
@@ -1721,12 +1747,31 @@ void Unit::SetFlag(int x,int val) {
 void Unit::CopyFlags(Unit * x) {
 	flags = x->flags;
 	if (x->guard != GUARD_SET && x->guard != GUARD_ADVANCE)
-		guard = x->guard;
+		SetGuard(x->guard);
 	else
-		guard = GUARD_NONE;
+		SetGuard(GUARD_NONE);
 	reveal = x->reveal;
 }
 
+//
+// Guarding units and wandering monsters are counted by their region, so
+// change the guard status or type through here once the unit is in the
+// world.
+//
+void Unit::SetGuard(int g) {
+	ARegion *r = object ? object->region : 0;
+	if (r) r->CountUnit(this, -1);
+	guard = g;
+	if (r) r->CountUnit(this, 1);
+}
+
+void Unit::SetType(int t) {
+	ARegion *r = object ? object->region : 0;
+	if (r) r->CountUnit(this, -1);
+	type = t;
+	if (r) r->CountUnit(this, 1);
+}
+
 int Unit::GetBattleItem(int index) {
 	forlist(&items) {
 		Item *pItem = (Item *) elem;
@@ -1863,9 +1908,25 @@ int Unit::GetWeapon(int index, int riding, int ridingBonus, int &attackBonus,
 }
 
 void Unit::MoveUnit(Object *toobj) {
-	if (object) object->units.Remove(this);
+	InvalidateVision();
+	if (object) {
+		if (object->region) object->region->CountUnit(this, -1);
+		object->units.Remove(this);
+	}
 	object = toobj;
-	if (object) object->units.Add(this);
+	if (object) {
+		object->units.Add(this);
+		if (object->region) object->region->CountUnit(this, 1);
+		if (!GetLiveUnit(num)) SetLiveUnit(num, this);
+	} else if (GetLiveUnit(num) == this) {
+		SetLiveUnit(num, 0);
+	}
+}
+
+void Unit::SetNum(int newnum) {
+	if (GetLiveUnit(num) == this) SetLiveUnit(num, 0);
+	num = newnum;
+	if (object && !GetLiveUnit(num)) SetLiveUnit(num, this);
 }
 
 void Unit::Event(const AString & s) {
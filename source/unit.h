@@ -102,6 +102,14 @@ class UnitPtr : public AListElem {
 };
 UnitPtr *GetUnitList(AList *, Unit *);
 
+//
+// Units that are currently in the world, by number.  MoveUnit enters a
+// unit when it is placed in an object and drops it when it is taken out of
+// the world, as does deleting it.  The unit's object and region give its
+// location, so moving units or objects needs no extra bookkeeping.
+//
+Unit *GetLiveUnit(int);
+
 class Unit : public AListElem {
 	public:
 		Unit();
@@ -199,6 +207,8 @@ class Unit : public AListElem {
 		int GetFlag(int);
 		void SetFlag(int,int);
 		void CopyFlags(Unit *);
+		void SetGuard(int);
+		void SetType(int);
 		int GetBattleItem(int index);
 		int GetArmor(int index, int ass);
 		int GetMount(int index, int canFly, int canRide, int &bonus, bool alwaysGet);
@@ -209,6 +219,7 @@ class Unit : public AListElem {
 		int Taxers();
 
 		void MoveUnit( Object *newobj );
+		void SetNum( int newnum );
 
 		void Event(const AString &);
 		void Error(const AString &);
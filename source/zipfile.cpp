@@ -0,0 +1,626 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#include "zipfile.h"
+
+#include <string.h>
+#include <time.h>
+
+//
+// A small deflate (RFC 1951) compressor.  Text is gathered in a 64K
+// window; each time the window fills, the new half is matched against
+// the 32K before it with hash chains and lazy matching, and written out
+// as one block with whichever Huffman codes, its own or the fixed ones,
+// come out smaller.
+//
+#define WSIZE 32768
+#define HBITS 15
+#define HSIZE (1 << HBITS)
+#define MIN_MATCH 3
+#define MAX_MATCH 258
+#define MAX_CHAIN 128
+#define NICE_MATCH 128
+#define OUTSIZE 16384
+
+#define LITERALS 286
+#define DISTANCES 30
+#define LENCODES 19
+
+static const int lengthBase[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int lengthExtra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const int distBase[DISTANCES] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+	8193, 12289, 16385, 24577
+};
+static const int distExtra[DISTANCES] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+/* The order the code length code lengths are sent in */
+static const int lencodeOrder[LENCODES] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+static const unsigned long crcTable[16] = {
+	0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+	0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+	0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+	0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+};
+
+struct DeflateState {
+	unsigned char win[2 * WSIZE];
+	int have; /* Bytes in win */
+	int done; /* Bytes in win already written out */
+	int head[HSIZE];
+	int prev[2 * WSIZE];
+
+	/* The block being built: a literal has dist 0, a match its length */
+	unsigned short value[2 * WSIZE];
+	unsigned short dist[2 * WSIZE];
+	int nsyms;
+
+	unsigned char lengthCode[MAX_MATCH + 1];
+
+	unsigned long bits;
+	int nbits;
+	unsigned char out[OUTSIZE];
+	int outlen;
+	unsigned long written;
+	ofstream *file;
+};
+
+static void FlushOut(DeflateState *z) {
+	z->file->write((char *) z->out, z->outlen);
+	z->written += z->outlen;
+	z->outlen = 0;
+}
+
+static void PutBits(DeflateState *z, unsigned int value, int n) {
+	z->bits |= (unsigned long) value << z->nbits;
+	z->nbits += n;
+	while (z->nbits >= 8) {
+		z->out[z->outlen++] = (unsigned char) (z->bits & 0xff);
+		if (z->outlen == OUTSIZE) FlushOut(z);
+		z->bits >>= 8;
+		z->nbits -= 8;
+	}
+}
+
+static int Hash(DeflateState *z, int p) {
+	return ((z->win[p] << 10) ^ (z->win[p + 1] << 5) ^ z->win[p + 2]) &
+		(HSIZE - 1);
+}
+
+static void Insert(DeflateState *z, int p) {
+	if (p + MIN_MATCH > z->have) return;
+	int h = Hash(z, p);
+	z->prev[p] = z->head[h];
+	z->head[h] = p;
+}
+
+//
+// Add p to the hash chains and return the longest earlier match for the
+// text at p, setting *dist to how far back it is.
+//
+static int FindMatch(DeflateState *z, int p, int *dist) {
+	int limit = z->have - p;
+	if (limit > MAX_MATCH) limit = MAX_MATCH;
+	if (limit < MIN_MATCH) return 0;
+
+	int h = Hash(z, p);
+	int q = z->head[h];
+	z->prev[p] = q;
+	z->head[h] = p;
+
+	int best = 0;
+	int chain = MAX_CHAIN;
+	unsigned char *s = z->win + p;
+	while (q >= 0 && p - q <= WSIZE && chain--) {
+		unsigned char *t = z->win + q;
+		if (t[best] == s[best] && t[0] == s[0]) {
+			int len = 0;
+			while (len < limit && t[len] == s[len]) len++;
+			if (len > best) {
+				best = len;
+				*dist = p - q;
+				if (len >= NICE_MATCH || len == limit) break;
+			}
+		}
+		q = z->prev[q];
+	}
+	return best >= MIN_MATCH ? best : 0;
+}
+
+static void AddSymbol(DeflateState *z, int value, int dist) {
+	z->value[z->nsyms] = (unsigned short) value;
+	z->dist[z->nsyms] = (unsigned short) dist;
+	z->nsyms++;
+}
+
+static int DistCode(int dist) {
+	int c = DISTANCES - 1;
+	while (distBase[c] > dist) c--;
+	return c;
+}
+
+//
+// Set lens to Huffman code lengths, no longer than maxbits, for symbols
+// with the given frequencies.  Symbols that never occur get no code.
+//
+static void BuildLengths(const int *freq, int n, int maxbits,
+		unsigned char *lens) {
+	int sym[LITERALS];
+	int weight[2 * LITERALS];
+	int parent[2 * LITERALS];
+	int depth[2 * LITERALS];
+	int scale = 0;
+
+	for (;;) {
+		int m = 0;
+		int i;
+		for (i = 0; i < n; i++) {
+			lens[i] = 0;
+			if (freq[i]) sym[m++] = i;
+		}
+		if (m == 0) return;
+		if (m == 1) {
+			lens[sym[0]] = 1;
+			return;
+		}
+
+		/* Sort the symbols by weight, rarest first */
+		for (i = 0; i < m; i++) {
+			int w = freq[sym[i]] >> scale;
+			weight[i] = w ? w : 1;
+		}
+		for (i = 1; i < m; i++) {
+			int s = sym[i], w = weight[i];
+			int j = i;
+			while (j > 0 && weight[j - 1] > w) {
+				sym[j] = sym[j - 1];
+				weight[j] = weight[j - 1];
+				j--;
+			}
+			sym[j] = s;
+			weight[j] = w;
+		}
+
+		/* Leaves and new nodes both come off in weight order */
+		int leaf = 0, node = m;
+		for (int next = m; next < 2 * m - 1; next++) {
+			int pick[2];
+			for (int k = 0; k < 2; k++) {
+				if (leaf < m && (node >= next || weight[leaf] <= weight[node]))
+					pick[k] = leaf++;
+				else
+					pick[k] = node++;
+			}
+			weight[next] = weight[pick[0]] + weight[pick[1]];
+			parent[pick[0]] = parent[pick[1]] = next;
+		}
+
+		int longest = 0;
+		depth[2 * m - 2] = 0;
+		for (i = 2 * m - 3; i >= 0; i--) {
+			depth[i] = depth[parent[i]] + 1;
+			if (i < m && depth[i] > longest) longest = depth[i];
+		}
+		if (longest <= maxbits) {
+			for (i = 0; i < m; i++) lens[sym[i]] = (unsigned char) depth[i];
+			return;
+		}
+		/* Too deep; flatten the weights and try again */
+		scale++;
+	}
+}
+
+/* Canonical codes for lens, bit-reversed since deflate sends them LSB first */
+static void BuildCodes(const unsigned char *lens, int n, unsigned short *codes) {
+	int count[16];
+	int next[16];
+	int i;
+	for (i = 0; i < 16; i++) count[i] = 0;
+	for (i = 0; i < n; i++) count[lens[i]]++;
+	count[0] = 0;
+	int code = 0;
+	for (i = 1; i < 16; i++) {
+		code = (code + count[i - 1]) << 1;
+		next[i] = code;
+	}
+	for (i = 0; i < n; i++) {
+		int len = lens[i];
+		if (!len) continue;
+		int c = next[len]++;
+		int r = 0;
+		for (int b = 0; b < len; b++) {
+			r = (r << 1) | (c & 1);
+			c >>= 1;
+		}
+		codes[i] = (unsigned short) r;
+	}
+}
+
+static void FixedLengths(unsigned char *lit, unsigned char *dst) {
+	int i;
+	for (i = 0; i < 144; i++) lit[i] = 8;
+	for (; i < 256; i++) lit[i] = 9;
+	for (; i < 280; i++) lit[i] = 7;
+	for (; i < 288; i++) lit[i] = 8;
+	for (i = 0; i < DISTANCES; i++) dst[i] = 5;
+}
+
+//
+// Match everything in the window not yet written, and write it out as
+// one block.
+//
+static void WriteBlock(DeflateState *z, int last) {
+	int p = z->done;
+	int pending = 0, plen = 0, pdist = 0;
+	z->nsyms = 0;
+	while (p <= z->have) {
+		int len = 0, dist = 0;
+		if (p < z->have) {
+			if (pending && plen >= NICE_MATCH) Insert(z, p);
+			else len = FindMatch(z, p, &dist);
+		}
+		if (pending) {
+			if (plen >= MIN_MATCH && len <= plen) {
+				/* The match at p - 1 wins; p - 1 and p are hashed */
+				AddSymbol(z, plen, pdist);
+				for (int q = p + 1; q < p - 1 + plen; q++) Insert(z, q);
+				p += plen - 1;
+				pending = 0;
+				continue;
+			}
+			AddSymbol(z, z->win[p - 1], 0);
+		}
+		if (p == z->have) break;
+		pending = 1;
+		plen = len;
+		pdist = dist;
+		p++;
+	}
+	z->done = z->have;
+
+	int litfreq[LITERALS];
+	int distfreq[DISTANCES];
+	int i;
+	for (i = 0; i < LITERALS; i++) litfreq[i] = 0;
+	for (i = 0; i < DISTANCES; i++) distfreq[i] = 0;
+	for (i = 0; i < z->nsyms; i++) {
+		if (z->dist[i]) {
+			litfreq[257 + z->lengthCode[z->value[i]]]++;
+			distfreq[DistCode(z->dist[i])]++;
+		} else {
+			litfreq[z->value[i]]++;
+		}
+	}
+	litfreq[256] = 1;
+
+	/* Some decoders want two codes in each tree */
+	int used = 0;
+	for (i = 0; i < 256; i++) if (litfreq[i]) used++;
+	if (!used) litfreq[0] = 1;
+	used = 0;
+	for (i = 0; i < DISTANCES; i++) if (distfreq[i]) used++;
+	for (i = 0; used < 2; i++) {
+		if (!distfreq[i]) {
+			distfreq[i] = 1;
+			used++;
+		}
+	}
+
+	unsigned char litlen[288];
+	unsigned char distlen[DISTANCES];
+	BuildLengths(litfreq, LITERALS, 15, litlen);
+	BuildLengths(distfreq, DISTANCES, 15, distlen);
+
+	int nlit = LITERALS, ndist = DISTANCES;
+	while (nlit > 257 && !litlen[nlit - 1]) nlit--;
+	while (ndist > 1 && !distlen[ndist - 1]) ndist--;
+
+	/* Run-length code the code lengths: 16 repeats, 17 and 18 are zeros */
+	unsigned char all[LITERALS + DISTANCES];
+	unsigned char rle[LITERALS + DISTANCES];
+	unsigned char rlextra[LITERALS + DISTANCES];
+	int nall = 0, nrle = 0;
+	for (i = 0; i < nlit; i++) all[nall++] = litlen[i];
+	for (i = 0; i < ndist; i++) all[nall++] = distlen[i];
+	for (i = 0; i < nall;) {
+		int run = 1;
+		while (i + run < nall && all[i + run] == all[i]) run++;
+		if (!all[i] && run >= 3) {
+			if (run > 138) run = 138;
+			rle[nrle] = run >= 11 ? 18 : 17;
+			rlextra[nrle++] = (unsigned char) (run - (run >= 11 ? 11 : 3));
+			i += run;
+		} else if (all[i] && run >= 4) {
+			if (run > 7) run = 7;
+			rle[nrle] = all[i];
+			rlextra[nrle++] = 0;
+			rle[nrle] = 16;
+			rlextra[nrle++] = (unsigned char) (run - 4);
+			i += run;
+		} else {
+			rle[nrle] = all[i];
+			rlextra[nrle++] = 0;
+			i++;
+		}
+	}
+	int lenfreq[LENCODES];
+	for (i = 0; i < LENCODES; i++) lenfreq[i] = 0;
+	for (i = 0; i < nrle; i++) lenfreq[rle[i]]++;
+	unsigned char lenlen[LENCODES];
+	BuildLengths(lenfreq, LENCODES, 7, lenlen);
+	int nlen = LENCODES;
+	while (nlen > 4 && !lenlen[lencodeOrder[nlen - 1]]) nlen--;
+
+	/* Pick the dynamic or the fixed codes, whichever is shorter */
+	unsigned char fixlit[288];
+	unsigned char fixdist[DISTANCES];
+	FixedLengths(fixlit, fixdist);
+	long dynamic = 14 + 3 * nlen;
+	long fixed = 0;
+	for (i = 0; i < nrle; i++) {
+		dynamic += lenlen[rle[i]];
+		if (rle[i] == 16) dynamic += 2;
+		if (rle[i] == 17) dynamic += 3;
+		if (rle[i] == 18) dynamic += 7;
+	}
+	for (i = 0; i < LITERALS; i++) {
+		dynamic += (long) litfreq[i] * litlen[i];
+		fixed += (long) litfreq[i] * fixlit[i];
+	}
+	for (i = 0; i < DISTANCES; i++) {
+		dynamic += (long) distfreq[i] * distlen[i];
+		fixed += (long) distfreq[i] * fixdist[i];
+	}
+
+	unsigned short litcode[288];
+	unsigned short distcode[DISTANCES];
+	PutBits(z, last, 1);
+	if (fixed <= dynamic) {
+		PutBits(z, 1, 2);
+		memcpy(litlen, fixlit, sizeof(litlen));
+		memcpy(distlen, fixdist, sizeof(distlen));
+		BuildCodes(litlen, 288, litcode);
+		BuildCodes(distlen, DISTANCES, distcode);
+	} else {
+		unsigned short lencode[LENCODES];
+		BuildCodes(lenlen, LENCODES, lencode);
+		BuildCodes(litlen, nlit, litcode);
+		BuildCodes(distlen, ndist, distcode);
+		PutBits(z, 2, 2);
+		PutBits(z, nlit - 257, 5);
+		PutBits(z, ndist - 1, 5);
+		PutBits(z, nlen - 4, 4);
+		for (i = 0; i < nlen; i++) PutBits(z, lenlen[lencodeOrder[i]], 3);
+		for (i = 0; i < nrle; i++) {
+			PutBits(z, lencode[rle[i]], lenlen[rle[i]]);
+			if (rle[i] == 16) PutBits(z, rlextra[i], 2);
+			if (rle[i] == 17) PutBits(z, rlextra[i], 3);
+			if (rle[i] == 18) PutBits(z, rlextra[i], 7);
+		}
+	}
+
+	for (i = 0; i < z->nsyms; i++) {
+		if (z->dist[i]) {
+			int len = z->value[i];
+			int lc = z->lengthCode[len];
+			PutBits(z, litcode[257 + lc], litlen[257 + lc]);
+			if (lengthExtra[lc])
+				PutBits(z, len - lengthBase[lc], lengthExtra[lc]);
+			int d = z->dist[i];
+			int dc = DistCode(d);
+			PutBits(z, distcode[dc], distlen[dc]);
+			if (distExtra[dc]) PutBits(z, d - distBase[dc], distExtra[dc]);
+		} else {
+			PutBits(z, litcode[z->value[i]], litlen[z->value[i]]);
+		}
+	}
+	PutBits(z, litcode[256], litlen[256]);
+
+	if (last) {
+		if (z->nbits) PutBits(z, 0, 8 - z->nbits);
+		FlushOut(z);
+	}
+}
+
+/* Drop the older half of a full window, keeping the newer as history */
+static void Slide(DeflateState *z) {
+	int i;
+	memmove(z->win, z->win + WSIZE, WSIZE);
+	for (i = 0; i < HSIZE; i++)
+		z->head[i] = z->head[i] >= WSIZE ? z->head[i] - WSIZE : -1;
+	for (i = 0; i < WSIZE; i++) {
+		int q = z->prev[i + WSIZE];
+		z->prev[i] = q >= WSIZE ? q - WSIZE : -1;
+	}
+	z->have -= WSIZE;
+	z->done -= WSIZE;
+}
+
+static void PutLong(unsigned char *p, unsigned long v) {
+	p[0] = (unsigned char) (v & 0xff);
+	p[1] = (unsigned char) ((v >> 8) & 0xff);
+	p[2] = (unsigned char) ((v >> 16) & 0xff);
+	p[3] = (unsigned char) ((v >> 24) & 0xff);
+}
+
+static void PutShort(unsigned char *p, unsigned int v) {
+	p[0] = (unsigned char) (v & 0xff);
+	p[1] = (unsigned char) ((v >> 8) & 0xff);
+}
+
+Azipfile::Azipfile() {
+	file = new ofstream;
+	z = 0;
+}
+
+Azipfile::~Azipfile() {
+	delete z;
+	delete file;
+}
+
+int Azipfile::OpenByName(const AString &zipname, const AString &n) {
+	AString temp = zipname;
+	file->open(temp.Str(), ios::out | ios::trunc | ios::binary);
+	if (!file->rdbuf()->is_open()) return -1;
+
+	name = n;
+	crc = 0xffffffffUL;
+	size = 0;
+	csize = 0;
+
+	time_t now = time(0);
+	struct tm t;
+#ifdef WIN32
+	localtime_s(&t, &now);
+#else
+	localtime_r(&now, &t);
+#endif
+	if (t.tm_year < 80) {
+		dostime = 0;
+		dosdate = (1 << 5) | 1;
+	} else {
+		dostime = (t.tm_hour << 11) | (t.tm_min << 5) | (t.tm_sec / 2);
+		dosdate = ((t.tm_year - 80) << 9) | ((t.tm_mon + 1) << 5) | t.tm_mday;
+	}
+
+	z = new DeflateState;
+	z->have = 0;
+	z->done = 0;
+	int i;
+	for (i = 0; i < HSIZE; i++) z->head[i] = -1;
+	for (i = 0; i < 29; i++) {
+		int top = i < 28 ? lengthBase[i + 1] : MAX_MATCH + 1;
+		for (int len = lengthBase[i]; len < top; len++)
+			z->lengthCode[len] = (unsigned char) i;
+	}
+	z->lengthCode[MAX_MATCH] = 28;
+	z->bits = 0;
+	z->nbits = 0;
+	z->outlen = 0;
+	z->written = 0;
+	z->file = file;
+
+	PutHeader(0);
+	return 0;
+}
+
+void Azipfile::Put(const char *s, int len) {
+	if (!z) return;
+	size += len;
+	for (int i = 0; i < len; i++) {
+		crc = (crc >> 4) ^ crcTable[(crc ^ (unsigned char) s[i]) & 15];
+		crc = (crc >> 4) ^ crcTable[(crc ^ ((unsigned char) s[i] >> 4)) & 15];
+	}
+	while (len) {
+		int room = 2 * WSIZE - z->have;
+		int n = len < room ? len : room;
+		memcpy(z->win + z->have, s, n);
+		z->have += n;
+		s += n;
+		len -= n;
+		if (z->have == 2 * WSIZE) {
+			WriteBlock(z, 0);
+			Slide(z);
+		}
+	}
+}
+
+//
+// The local header goes out before the data, when its size and checksum
+// are not known yet; Close() comes back and fills them in.
+//
+void Azipfile::PutHeader(int central) {
+	unsigned char h[46];
+	int n = 0;
+	if (central) {
+		PutLong(h, 0x02014b50UL);
+		PutShort(h + 4, (3 << 8) | 20); /* Made on Unix, version 2.0 */
+		n = 6;
+	} else {
+		PutLong(h, 0x04034b50UL);
+		n = 4;
+	}
+	PutShort(h + n, 20); /* Version needed to extract */
+	PutShort(h + n + 2, 0);
+	PutShort(h + n + 4, 8); /* Deflated */
+	PutShort(h + n + 6, dostime);
+	PutShort(h + n + 8, dosdate);
+	PutLong(h + n + 10, crc ^ 0xffffffffUL);
+	PutLong(h + n + 14, csize);
+	PutLong(h + n + 18, size);
+	PutShort(h + n + 22, name.Len());
+	PutShort(h + n + 24, 0);
+	n += 26;
+	if (central) {
+		PutShort(h + n, 0); /* Comment */
+		PutShort(h + n + 2, 0); /* Disk */
+		PutShort(h + n + 4, 1); /* Text */
+		PutLong(h + n + 6, 0100644UL << 16);
+		PutLong(h + n + 10, 0); /* The local header is at the start */
+		n += 14;
+	}
+	file->write((char *) h, n);
+	file->write(name.Str(), name.Len());
+}
+
+void Azipfile::Close() {
+	if (!z) return;
+	WriteBlock(z, 1);
+	csize = z->written;
+	delete z;
+	z = 0;
+
+	long local = 30 + name.Len();
+	long central = local + csize;
+	file->seekp(14, ios::beg);
+	unsigned char h[22];
+	PutLong(h, crc ^ 0xffffffffUL);
+	PutLong(h + 4, csize);
+	PutLong(h + 8, size);
+	file->write((char *) h, 12);
+	file->seekp(central, ios::beg);
+
+	PutHeader(1);
+	PutLong(h, 0x06054b50UL);
+	PutShort(h + 4, 0);
+	PutShort(h + 6, 0);
+	PutShort(h + 8, 1);
+	PutShort(h + 10, 1);
+	PutLong(h + 12, 46 + name.Len());
+	PutLong(h + 16, central);
+	PutShort(h + 20, 0);
+	file->write((char *) h, 22);
+	file->close();
+}
@@ -0,0 +1,67 @@
+// START A3HEADER
+//
+// This source file is part of the Atlantis PBM game program.
+// Copyright (C) 1995-1999 Geoff Dunbar
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program, in the file license.txt. If not, write
+// to the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+// Boston, MA 02111-1307, USA.
+//
+// See the Atlantis Project web page for details:
+// http://www.prankster.com/project
+//
+// END A3HEADER
+#ifndef ZIPFILE_CLASS
+#define ZIPFILE_CLASS
+
+#include "astring.h"
+
+#include <fstream>
+
+using namespace std;
+
+struct DeflateState;
+
+//
+// Azipfile writes a zip archive holding a single file, deflating the
+// text as it is put, so a report can be written zipped without first
+// being written out in full.  Close() finishes the archive.
+//
+class Azipfile {
+	public:
+		Azipfile();
+		~Azipfile();
+
+		//
+		// Open the archive zipname, to hold a file called name.  Returns
+		// -1 if the archive could not be created.
+		//
+		int OpenByName(const AString &zipname, const AString &name);
+		void Put(const char *, int);
+		void Close();
+
+	private:
+		void PutHeader(int central);
+
+		ofstream *file;
+		DeflateState *z;
+		AString name;
+		unsigned long crc;
+		unsigned long size;
+		unsigned long csize;
+		unsigned int dostime;
+		unsigned int dosdate;
+};
+
+#endif